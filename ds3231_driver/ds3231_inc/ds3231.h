@@ -43,7 +43,7 @@ extern "C"
 	/**
 	 * @brief The init function
 	 *
-	 * Implements the init function. Must be called first to initialize.
+	 * Implements the init function. Must be called first to initialize. With the runtime policy feature, the policy of the handle is set to DS3231_POLICY_SAFE.
 	 *
 	 * @param handle: pointer to a handle of DS3231
 	 * @return Returns 0 for no error
@@ -363,6 +363,71 @@ extern "C"
 	 */
 	ds3231_error_code_t _ds3231_hex_to_bcd(uint8_t *data);
 
+#if DS3231_INCLUDE_ALARM_1 | DS3231_INCLUDE_ALARM_2
+	/**
+	 * @brief The alarm register value function
+	 *
+	 * Masks the mask bit and the day/date select bit out of an alarm register, and converts the value from BCD.
+	 *
+	 * @param data: the alarm register
+	 * @param value_mask: the bits of the BCD value
+	 * @return Returns the value
+	 */
+	uint8_t _ds3231_alarm_register_value(const uint8_t data, const uint8_t value_mask);
+#endif
+
+	/**
+	 * @brief The time block BCD to HEX function
+	 *
+	 * Masks and converts all 7 time and calendar registers from BCD to HEX at once.
+	 *
+	 * @param data: an array of 7 bytes, seconds first
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_time_block_bcd_to_hex(uint8_t *data);
+
+	/**
+	 * @brief The time block HEX to BCD function
+	 *
+	 * Converts and masks all 7 time and calendar values (range: 0 to 99) from HEX to BCD at once.
+	 *
+	 * @param data: an array of 7 bytes, seconds first
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_time_block_hex_to_bcd(uint8_t *data);
+
+#if DS3231_INCLUDE_BCD_SWAR
+	/**
+	 * @brief The time block load function
+	 *
+	 * Packs the 7 time and calendar bytes into a 64 bit word, seconds in the least significant byte.
+	 *
+	 * @param data: an array of 7 bytes, seconds first
+	 * @return Returns the packed word
+	 */
+	uint64_t _ds3231_time_block_load(const uint8_t *data);
+
+	/**
+	 * @brief The time block store function
+	 *
+	 * Unpacks a 64 bit word into the 7 time and calendar bytes.
+	 *
+	 * @param block: the packed word, seconds in the least significant byte
+	 * @param data: an array of 7 bytes, seconds first
+	 */
+	void _ds3231_time_block_store(uint64_t block, uint8_t *data);
+
+	/**
+	 * @brief The SWAR HEX to BCD function
+	 *
+	 * Converts four values of 0 to 99, each in a 16 bit lane, from HEX to BCD.
+	 *
+	 * @param lanes: four 16 bit lanes
+	 * @return Returns the four converted lanes
+	 */
+	uint64_t _ds3231_swar_hex_to_bcd(uint64_t lanes);
+#endif
+
 	/**
 	 * @brief The bit get function
 	 *
@@ -444,6 +509,18 @@ extern "C"
 	 */
 	ds3231_error_code_t ds3231_sqw_output_wave_frequency(const ds3231_handle_t *handle, const ds3231_sqw_output_wave_frequency_t wave_freq);
 
+	/**
+	 * @brief The get status block function
+	 *
+	 * Reads the control, status, aging offset and temperature registers in one burst and decodes them, e.g. for a periodic health check.
+	 * Does not start a temperature conversion, the temperature is the one of the last conversion, made by DS3231 every 64 seconds.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param block: pointer to a ds3231_status_block_t struct that returns the decoded registers
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_get_status_block(const ds3231_handle_t *handle, ds3231_status_block_t *block);
+
 #if DS3231_INCLUDE_AGING_OFFSET_CALIBRATION
 	/**
 	 * @brief The aging offset calibration function
@@ -456,9 +533,77 @@ extern "C"
 	 */
 	ds3231_error_code_t ds3231_aging_offset_calibration(const ds3231_handle_t *handle, const int8_t offset);
 #define ds3231_aging_offset_calibration_reset(handle_pointer) ds3231_aging_offset_calibration((handle_pointer), ((int8_t)(0)));
+
+	/**
+	 * @brief The get aging offset function
+	 *
+	 * Reads the aging offset currently in DS3231.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param offset: pointer to an int8_t variable that returns the aging offset
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_get_aging_offset(const ds3231_handle_t *handle, int8_t *offset);
 #endif
 
+	/**
+	 * @brief The raw temperature to centi degrees function
+	 *
+	 * @param raw: temperature in quarter degrees, as returned by ds3231_get_temperature_raw
+	 * @return Returns the temperature multiplied by 100, e.g. 2575 for 25.75
+	 */
+	static inline int16_t ds3231_temperature_raw_to_centi(const int16_t raw)
+	{
+		return (int16_t)(raw * 25);
+	}
+
+	/**
+	 * @brief The raw temperature to milli degrees function
+	 *
+	 * @param raw: temperature in quarter degrees, as returned by ds3231_get_temperature_raw
+	 * @return Returns the temperature multiplied by 1000, e.g. 25750 for 25.75
+	 */
+	static inline int32_t ds3231_temperature_raw_to_milli(const int16_t raw)
+	{
+		return (int32_t)raw * 250;
+	}
+
+	/**
+	 * @brief The raw temperature to float function
+	 *
+	 * Only pulls in floating point math where it is called, e.g. offline on the stored raw values.
+	 *
+	 * @param raw: temperature in quarter degrees, as returned by ds3231_get_temperature_raw
+	 * @return Returns the temperature in degrees
+	 */
+	static inline float ds3231_temperature_raw_to_float(const int16_t raw)
+	{
+		return (float)raw * 0.25f;
+	}
+
+	/**
+	 * @brief The temperature raw function
+	 *
+	 * Assembles the temperature registers into a signed number of quarter degrees, MSB << 2 | LSB >> 6 with the sign of the MSB.
+	 *
+	 * @param data: pointer to the temperature MSB followed by the LSB
+	 * @return Returns the temperature in quarter degrees, e.g. 103 for 25.75 and -1 for -0.25
+	 */
+	int16_t _ds3231_temperature_raw(const uint8_t *data);
+
 #if DS3231_INCLUDE_TEMPERATURE
+	/**
+	 * @brief The get raw temperature function
+	 *
+	 * Starts a temperature conversion, waits for it and returns the native value of DS3231 in quarter degrees, without any arithmetic.
+	 * Convert it when needed with ds3231_temperature_raw_to_centi, ds3231_temperature_raw_to_milli or ds3231_temperature_raw_to_float.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param raw: pointer to an int16_t variable that returns the temperature in quarter degrees, e.g. 103 for 25.75
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_get_temperature_raw(const ds3231_handle_t *handle, int16_t *raw);
+
 #if DS3231_INCLUDE_TEMPERATURE_FLOAT_MATH
 	/**
 	 * @brief The get temperature function
@@ -544,6 +689,92 @@ extern "C"
 	 * @return Returns 0 for no error
 	 */
 	ds3231_error_code_t ds3231_alarm_1_flag_clear(const ds3231_handle_t *handle);
+
+	/**
+	 * @brief The alarm 1 encode function
+	 *
+	 * Builds the image of the 4 alarm 1 registers from a config, with the BCD values, the mask bits of the rate and the day/date select bit. Does not access DS3231.
+	 *
+	 * @param config: pointer to ds3231_alarm_1_config_t struct
+	 * @param data: pointer to 4 bytes that return the registers
+	 */
+	void _ds3231_alarm_1_encode(const ds3231_alarm_1_config_t *config, uint8_t *data);
+
+	/**
+	 * @brief The alarm 1 get config function
+	 *
+	 * Reads the alarm 1 registers, 0x07 to 0x0A, in one burst and decodes them into a config, so a config programmed before a reset can be compared instead of rewritten.
+	 * The value of a masked register is returned as programmed, as is the day/date select of a masked day/date.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param config: pointer to ds3231_alarm_1_config_t struct that returns the config
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_alarm_1_get_config(const ds3231_handle_t *handle, ds3231_alarm_1_config_t *config);
+
+	/**
+	 * @brief The alarm 1 decode function
+	 *
+	 * The inverse of _ds3231_alarm_1_encode, finds the rate from the mask bits and converts the values from BCD. Does not access DS3231.
+	 *
+	 * @param data: pointer to the 4 alarm 1 registers
+	 * @param config: pointer to ds3231_alarm_1_config_t struct that returns the config
+	 * @return Returns 0 for no error, DS3231_ERROR_ALARM_INVALID_MASK if the mask bits are not those of a rate
+	 */
+	ds3231_error_code_t _ds3231_alarm_1_decode(const uint8_t *data, ds3231_alarm_1_config_t *config);
+
+#if DS3231_INCLUDE_CALENDAR
+	/**
+	 * @brief The alarm 1 next fire function
+	 *
+	 * Computes the first time after now at which DS3231 fires alarm 1 with this config, in constant time and without accessing DS3231.
+	 * A date alarm skips the months without that date, e.g. the 31st fires only in the months of 31 days, and a day alarm uses the day of week numbering of ds3231_day_of_week.
+	 *
+	 * @param config: pointer to ds3231_alarm_1_config_t struct
+	 * @param now: the current time of DS3231, in seconds since 1970-01-01 00:00:00
+	 * @param next_fire: pointer to a ds3231_epoch_t variable that returns the next fire, always after now
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_alarm_1_next_fire(const ds3231_alarm_1_config_t *config, const ds3231_epoch_t now, ds3231_epoch_t *next_fire);
+
+	/**
+	 * @brief The alarm at epoch function
+	 *
+	 * Programs alarm 1 to fire once at an epoch with the tightest rate, the date match, which reaches up to the same date of the next month (28 to 31 days ahead).
+	 * Clears a stale alarm 1 flag and enables the alarm 1 interrupt. The time is not read, the caller passes the one it has, so a call is a 2 byte read of the control and
+	 * status registers and two writes, of the alarm 1 registers and of the control and status registers.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param now: the current time of DS3231 in seconds since 1970-01-01 00:00:00, e.g. from the last time read of the application
+	 * @param epoch: the time of the fire in seconds since 1970-01-01 00:00:00, after now
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_alarm_at(const ds3231_handle_t *handle, const ds3231_epoch_t now, const ds3231_epoch_t epoch);
+
+	/**
+	 * @brief The alarm in seconds function
+	 *
+	 * Programs alarm 1 to fire once this many seconds after now, the same way as ds3231_alarm_at.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param now: the current time of DS3231 in seconds since 1970-01-01 00:00:00, the delay counts from it
+	 * @param seconds: the delay of the fire, at least 1
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_alarm_in(const ds3231_handle_t *handle, const ds3231_epoch_t now, const uint32_t seconds);
+
+	/**
+	 * @brief The alarm 1 program epoch function
+	 *
+	 * Checks that the date match fires first at the epoch after now, and writes alarm 1, then the control and status registers read back with the interrupt enabled.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param now: the current time of DS3231
+	 * @param epoch: the time of the fire
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_alarm_1_program_epoch(const ds3231_handle_t *handle, const ds3231_epoch_t now, const ds3231_epoch_t epoch);
+#endif
 #endif
 
 #if DS3231_INCLUDE_ALARM_2
@@ -604,6 +835,986 @@ extern "C"
 	 * @return Returns 0 for no error
 	 */
 	ds3231_error_code_t ds3231_alarm_2_flag_clear(const ds3231_handle_t *handle);
+
+	/**
+	 * @brief The alarm 2 encode function
+	 *
+	 * Builds the image of the 3 alarm 2 registers from a config, with the BCD values, the mask bits of the rate and the day/date select bit. Does not access DS3231.
+	 *
+	 * @param config: pointer to ds3231_alarm_2_config_t struct
+	 * @param data: pointer to 3 bytes that return the registers
+	 */
+	void _ds3231_alarm_2_encode(const ds3231_alarm_2_config_t *config, uint8_t *data);
+
+	/**
+	 * @brief The alarm 2 get config function
+	 *
+	 * Reads the alarm 2 registers, 0x0B to 0x0D, in one burst and decodes them into a config, so a config programmed before a reset can be compared instead of rewritten.
+	 * The value of a masked register is returned as programmed, as is the day/date select of a masked day/date.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param config: pointer to ds3231_alarm_2_config_t struct that returns the config
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_alarm_2_get_config(const ds3231_handle_t *handle, ds3231_alarm_2_config_t *config);
+
+	/**
+	 * @brief The alarm 2 decode function
+	 *
+	 * The inverse of _ds3231_alarm_2_encode, finds the rate from the mask bits and converts the values from BCD. Does not access DS3231.
+	 *
+	 * @param data: pointer to the 3 alarm 2 registers
+	 * @param config: pointer to ds3231_alarm_2_config_t struct that returns the config
+	 * @return Returns 0 for no error, DS3231_ERROR_ALARM_INVALID_MASK if the mask bits are not those of a rate
+	 */
+	ds3231_error_code_t _ds3231_alarm_2_decode(const uint8_t *data, ds3231_alarm_2_config_t *config);
+
+#if DS3231_INCLUDE_CALENDAR
+	/**
+	 * @brief The alarm 2 next fire function
+	 *
+	 * Computes the first time after now at which DS3231 fires alarm 2 with this config, in constant time and without accessing DS3231. Alarm 2 fires at second 00 of the matching minute.
+	 * A date alarm skips the months without that date, e.g. the 31st fires only in the months of 31 days, and a day alarm uses the day of week numbering of ds3231_day_of_week.
+	 *
+	 * @param config: pointer to ds3231_alarm_2_config_t struct
+	 * @param now: the current time of DS3231, in seconds since 1970-01-01 00:00:00
+	 * @param next_fire: pointer to a ds3231_epoch_t variable that returns the next fire, always after now
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_alarm_2_next_fire(const ds3231_alarm_2_config_t *config, const ds3231_epoch_t now, ds3231_epoch_t *next_fire);
+#endif
+#endif
+
+#if DS3231_INCLUDE_ALARM_1 | DS3231_INCLUDE_ALARM_2
+	/**
+	 * @brief The alarm flags fetch and clear function
+	 *
+	 * Reads both alarm flags in one read of the status register and clears the set ones in one write, none if neither is set. OSF and EN32KHZ are written back as read.
+	 * It replaces a flag poll and a flag clear per alarm in an interrupt handler, a read and a write instead of around 10 transactions.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param alarm_1_flag: pointer to a ds3231_bool_t variable that returns DS3231_TRUE if alarm 1 fired
+	 * @param alarm_2_flag: pointer to a ds3231_bool_t variable that returns DS3231_TRUE if alarm 2 fired
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_alarm_flags_fetch_and_clear(const ds3231_handle_t *handle, ds3231_bool_t *alarm_1_flag, ds3231_bool_t *alarm_2_flag);
+#endif
+
+#if DS3231_INCLUDE_CALENDAR
+	/**
+	 * @brief The set all from date function
+	 *
+	 * Sets all of the time and calendar registers in one burst, like ds3231_set_all_time_and_calendar, but derives the day of week from the date.
+	 * The day member of time_struct is ignored and left untouched.
+	 *
+	 * @param handle: pointer to a handle of DS3231
+	 * @param time_struct: pointer to a struct of ds3231_time_and_calendar_t to set second, minute, hour, date, month, year
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_set_all_time_and_calendar_from_date(const ds3231_handle_t *handle, const ds3231_time_and_calendar_t *time_struct);
+
+	/**
+	 * @brief The set all from epoch function
+	 *
+	 * Sets all of the time and calendar registers in one burst from seconds since 1970-01-01 00:00:00. The day of week is derived from the date.
+	 *
+	 * @param handle: pointer to a handle of DS3231
+	 * @param epoch: seconds since 1970-01-01 00:00:00 (range: 1900-01-01 00:00:00 to 2099-12-31 23:59:59)
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_set_all_time_and_calendar_from_epoch(const ds3231_handle_t *handle, const ds3231_epoch_t epoch);
+
+	/**
+	 * @brief The day of week function
+	 *
+	 * Calculates the day of week of a date in constant time. Does not access DS3231.
+	 *
+	 * @param year: year (range: 1900 to 2099)
+	 * @param month: month (range: 1 to 12)
+	 * @param date: date (range: 1 to 31)
+	 * @param day: pointer to a ds3231_day_t variable that returns the day of week
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_day_of_week(const ds3231_year_t year, const ds3231_month_t month, const ds3231_date_t date, ds3231_day_t *day);
+
+	/**
+	 * @brief The time and calendar to epoch function
+	 *
+	 * Converts a time and calendar struct to seconds since 1970-01-01 00:00:00. The day member is not used. Does not access DS3231.
+	 *
+	 * @param time_struct: pointer to a ds3231_time_and_calendar_t struct
+	 * @param epoch: pointer to a ds3231_epoch_t variable
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_time_and_calendar_to_epoch(const ds3231_time_and_calendar_t *time_struct, ds3231_epoch_t *epoch);
+
+	/**
+	 * @brief The epoch to time and calendar function
+	 *
+	 * Converts seconds since 1970-01-01 00:00:00 to a time and calendar struct, including the day of week. Does not access DS3231.
+	 *
+	 * @param epoch: seconds since 1970-01-01 00:00:00
+	 * @param time_struct: pointer to a ds3231_time_and_calendar_t struct
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_epoch_to_time_and_calendar(const ds3231_epoch_t epoch, ds3231_time_and_calendar_t *time_struct);
+
+	/**
+	 * @brief The days from civil function
+	 *
+	 * Calculates the number of days since 1970-01-01 for a date, without loops or tables.
+	 *
+	 * @param year: year (range: 1900 to 2099)
+	 * @param month: month (range: 1 to 12)
+	 * @param date: date (range: 1 to 31)
+	 * @return Returns the number of days, negative before 1970
+	 */
+	int32_t _ds3231_days_from_civil(const ds3231_year_t year, const ds3231_month_t month, const ds3231_date_t date);
+
+	/**
+	 * @brief The civil from days function
+	 *
+	 * Fills the date, month and year of a time and calendar struct from the number of days since 1970-01-01.
+	 *
+	 * @param days: number of days since 1970-01-01, negative before 1970
+	 * @param time_struct: pointer to a ds3231_time_and_calendar_t struct
+	 */
+	void _ds3231_civil_from_days(int32_t days, ds3231_time_and_calendar_t *time_struct);
+
+	/**
+	 * @brief The day of week from days function
+	 *
+	 * Calculates the day of week from the number of days since 1970-01-01.
+	 *
+	 * @param days: number of days since 1970-01-01, negative before 1970
+	 * @return Returns the day of week
+	 */
+	ds3231_day_t _ds3231_day_of_week_from_days(const int32_t days);
+
+	/**
+	 * @brief The epoch from time block function
+	 *
+	 * Converts the 7 raw time and calendar registers, as read in a burst from DS3231, into seconds since 1970-01-01. The century bit is taken from the month register.
+	 *
+	 * @param data: pointer to the 7 raw BCD registers, not modified
+	 * @return Returns the epoch
+	 */
+	ds3231_epoch_t _ds3231_epoch_from_time_block(const uint8_t *data);
+
+	/**
+	 * @brief The time block from time and calendar function
+	 *
+	 * Converts a time struct into the 7 raw time and calendar registers, ready to be written in a burst to DS3231, with the century bit and 24H format.
+	 *
+	 * @param time_struct: pointer to a ds3231_time_and_calendar_t struct, in range
+	 * @param data: pointer to the 7 raw BCD registers
+	 */
+	void _ds3231_time_block_from_time_and_calendar(const ds3231_time_and_calendar_t *time_struct, uint8_t *data);
+
+#if DS3231_INCLUDE_ALARM_1 | DS3231_INCLUDE_ALARM_2
+	/**
+	 * @brief The next periodic match function
+	 *
+	 * @param now: the current time in seconds since 1970-01-01 00:00:00
+	 * @param period: the period of the match in seconds
+	 * @param offset: the match in seconds from the start of a period, periods start at 1970-01-01 00:00:00
+	 * @return Returns the first match after now
+	 */
+	ds3231_epoch_t _ds3231_next_periodic_match(const ds3231_epoch_t now, const ds3231_epoch_t period, const ds3231_epoch_t offset);
+
+	/**
+	 * @brief The next date match function
+	 *
+	 * Finds the first match after now of a date of the month and a time of day, skipping the months without that date. Looks at three months at most.
+	 *
+	 * @param now: the current time in seconds since 1970-01-01 00:00:00
+	 * @param date: the date of the month
+	 * @param second_of_day: the time of day of the match in seconds
+	 * @param next_match: pointer to a ds3231_epoch_t variable that returns the match
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_next_date_match(const ds3231_epoch_t now, const ds3231_date_t date, const int32_t second_of_day, ds3231_epoch_t *next_match);
+#endif
+#endif
+
+#if DS3231_INCLUDE_TIME_SYNC
+	/**
+	 * @brief The aligned time set function
+	 *
+	 * Sets DS3231 to the reference time plus an offset, with the write landing on a second boundary of the reference clock.
+	 * Writing the seconds register resets the countdown chain of DS3231, so its seconds then tick together with the reference. The bus latency is measured first, and the write starts early by half of it.
+	 * Blocks for up to a second, in the delay function and then polling the reference clock.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param offset: seconds added to the reference time, e.g. 0 to keep DS3231 in UTC
+	 * @param reference_clock: the reference clock, e.g. CLOCK_REALTIME under NTP
+	 * @param alignment_error_ns: pointer to a variable that returns how far the middle of the write was from the second boundary, in nanoseconds
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_set_time_aligned(const ds3231_handle_t *handle, const ds3231_epoch_t offset, ds3231_reference_clock_fp reference_clock, int64_t *alignment_error_ns);
+
+	/**
+	 * @brief The phase measurement function
+	 *
+	 * Finds the seconds edge of DS3231 on the reference clock without the SQW pin, and from it the offset of DS3231 from the reference.
+	 * The seconds register is polled every DS3231_SYNC_COARSE_STEP_MS until it changes, then each following second the bound of the edge is split in DS3231_SYNC_PARTS_PER_PASS
+	 * parts whose limits are probed in order by single reads, projected onto that second, up to the first read of the new second.
+	 * The bound is conservative, every read is taken to sample the register anywhere between its start and end. Takes about 30 transactions and 3 seconds for 1 ms,
+	 * and up to 50 transactions and 7 seconds for the best the bus allows.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param reference_clock: the reference clock, e.g. CLOCK_REALTIME or CLOCK_MONOTONIC
+	 * @param target_uncertainty_ns: the search stops once the edge is known within this, 0 for the best the bus allows
+	 * @param phase: pointer to a ds3231_phase_t struct that returns the measurement
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_measure_phase(const ds3231_handle_t *handle, ds3231_reference_clock_fp reference_clock, const int64_t target_uncertainty_ns, ds3231_phase_t *phase);
+
+	/**
+	 * @brief The timed read function
+	 *
+	 * Reads registers starting from the seconds register, and timestamps the start and the end of the transaction with the reference clock.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param reference_clock: the reference clock
+	 * @param data: pointer to the registers read
+	 * @param number_of_bytes: number of registers to read
+	 * @param before_ns: pointer to a variable that returns the reference time before the transaction
+	 * @param after_ns: pointer to a variable that returns the reference time after the transaction
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_sync_timed_read(const ds3231_handle_t *handle, ds3231_reference_clock_fp reference_clock, uint8_t *data, const uint8_t number_of_bytes, int64_t *before_ns, int64_t *after_ns);
+
+	/**
+	 * @brief The wait until function
+	 *
+	 * Waits until the reference clock reaches a deadline, in the delay function first and then polling the reference clock.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param reference_clock: the reference clock
+	 * @param deadline_ns: the reference time to wait for
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_sync_wait_until(const ds3231_handle_t *handle, ds3231_reference_clock_fp reference_clock, const int64_t deadline_ns);
+
+	/**
+	 * @brief The BCD second increment function
+	 *
+	 * @param second: a second in BCD
+	 * @return Returns the next second in BCD, 0x59 rolls over to 0x00
+	 */
+	uint8_t _ds3231_bcd_increment_second(const uint8_t second);
+#endif
+
+#if DS3231_INCLUDE_DRIFT_ESTIMATION
+	/**
+	 * @brief The drift init function
+	 *
+	 * Clears the drift history and reads the aging offset currently in DS3231. Call it once for a new board, then persist the ds3231_drift_t struct as is.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param drift: pointer to a ds3231_drift_t struct
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_drift_init(const ds3231_handle_t *handle, ds3231_drift_t *drift);
+
+	/**
+	 * @brief The drift sample function
+	 *
+	 * Locates a seconds edge of DS3231 on the reference clock with ds3231_measure_phase, within DS3231_DRIFT_EDGE_UNCERTAINTY_NS, and adds it to the history.
+	 * Takes a few seconds and a few dozen short reads.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param drift: pointer to a ds3231_drift_t struct
+	 * @param reference_clock: the reference clock, e.g. CLOCK_REALTIME under NTP
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_drift_sample(const ds3231_handle_t *handle, ds3231_drift_t *drift, ds3231_reference_clock_fp reference_clock);
+
+	/**
+	 * @brief The drift estimate function
+	 *
+	 * Estimates the drift of DS3231 from the history with the Theil-Sen estimator, the median of the slopes of all sample pairs, which ignores outliers like a missed edge or a reference clock step.
+	 * Does not access DS3231.
+	 *
+	 * @param drift: pointer to a ds3231_drift_t struct, not modified
+	 * @param drift_ppb: pointer to a variable that returns the drift in parts per billion. Positive means DS3231 runs fast
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_drift_estimate(const ds3231_drift_t *drift, int32_t *drift_ppb);
+
+	/**
+	 * @brief The drift update function
+	 *
+	 * Takes a sample, estimates the drift and, if it is beyond the hysteresis, applies a corrected aging offset and starts a new history. Meant to be called periodically.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param drift: pointer to a ds3231_drift_t struct
+	 * @param reference_clock: the reference clock, e.g. CLOCK_REALTIME under NTP
+	 * @param applied: pointer to a ds3231_bool_t variable that returns DS3231_TRUE if a new aging offset was applied
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_drift_update(const ds3231_handle_t *handle, ds3231_drift_t *drift, ds3231_reference_clock_fp reference_clock, ds3231_bool_t *applied);
+
+	/**
+	 * @brief The drift history reset function
+	 *
+	 * Clears the history but keeps the aging offset. Call it after setting the time of DS3231, since the step breaks the samples taken before it.
+	 *
+	 * @param drift: pointer to a ds3231_drift_t struct
+	 */
+	void ds3231_drift_reset_history(ds3231_drift_t *drift);
+#endif
+
+#if DS3231_INCLUDE_TIMER_SERVICE
+	/**
+	 * @brief The timer service init function
+	 *
+	 * Empties the timer service, clears the flag of its alarm and enables the alarm interrupt.
+	 * Please note that it does not set the output pin to interrupt, see ds3231_int_sqw_pin_select.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param service: pointer to a ds3231_timer_service_t struct
+	 * @param alarm: the hardware alarm used, alarm 1 for second resolution or alarm 2 for minute resolution
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_timer_service_init(const ds3231_handle_t *handle, ds3231_timer_service_t *service, const ds3231_timer_alarm_t alarm);
+
+	/**
+	 * @brief The timer init function
+	 *
+	 * Sets the callback of a timer and marks it as not started. Does not access DS3231.
+	 *
+	 * @param timer: pointer to a ds3231_timer_t struct
+	 * @param callback: the function called when the timer fires
+	 * @param context: passed to the callback as is
+	 */
+	void ds3231_timer_init(ds3231_timer_t *timer, ds3231_timer_callback_fp callback, void *context);
+
+	/**
+	 * @brief The timer start function
+	 *
+	 * Starts a timer, or moves it if it is already started, in O(log n). The hardware alarm is only written if the earliest deadline changes.
+	 * A deadline in the past fires on the next dispatch, a couple of seconds later.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param service: pointer to a ds3231_timer_service_t struct
+	 * @param timer: pointer to a ds3231_timer_t struct initialized with ds3231_timer_init
+	 * @param deadline: seconds since 1970-01-01 00:00:00 of the first fire, in the time of DS3231
+	 * @param period: seconds between the following fires, 0 for a one shot timer
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_timer_start(const ds3231_handle_t *handle, ds3231_timer_service_t *service, ds3231_timer_t *timer, const ds3231_epoch_t deadline, const uint32_t period);
+
+	/**
+	 * @brief The timer cancel function
+	 *
+	 * Stops a timer in O(log n), does nothing if it is not started. The hardware alarm is only written if the earliest deadline changes.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param service: pointer to a ds3231_timer_service_t struct
+	 * @param timer: pointer to a ds3231_timer_t struct
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_timer_cancel(const ds3231_handle_t *handle, ds3231_timer_service_t *service, ds3231_timer_t *timer);
+
+	/**
+	 * @brief The timer service dispatch function
+	 *
+	 * Call it when the alarm of the service fires, from a task and not from the interrupt itself since it uses the I2C bus.
+	 * Clears the alarm flag, calls the callbacks of all timers whose deadline passed, restarts the periodic ones and programs the next deadline.
+	 * The callbacks may start and cancel timers, the hardware alarm is written once at the end.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param service: pointer to a ds3231_timer_service_t struct
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_timer_service_dispatch(const ds3231_handle_t *handle, ds3231_timer_service_t *service);
+
+	/**
+	 * @brief The timer service program function
+	 *
+	 * Writes the earliest deadline into the hardware alarm, unless it is already there or the service is dispatching.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param service: pointer to a ds3231_timer_service_t struct
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_timer_service_program(const ds3231_handle_t *handle, ds3231_timer_service_t *service);
+
+	/**
+	 * @brief The timer heap sift up function
+	 *
+	 * @param service: pointer to a ds3231_timer_service_t struct
+	 * @param index: heap index of the timer to move towards the root
+	 */
+	void _ds3231_timer_heap_up(ds3231_timer_service_t *service, uint16_t index);
+
+	/**
+	 * @brief The timer heap sift down function
+	 *
+	 * @param service: pointer to a ds3231_timer_service_t struct
+	 * @param index: heap index of the timer to move towards the leaves
+	 */
+	void _ds3231_timer_heap_down(ds3231_timer_service_t *service, uint16_t index);
+
+	/**
+	 * @brief The timer heap remove function
+	 *
+	 * @param service: pointer to a ds3231_timer_service_t struct
+	 * @param timer: pointer to a started ds3231_timer_t struct
+	 */
+	void _ds3231_timer_heap_remove(ds3231_timer_service_t *service, ds3231_timer_t *timer);
+#endif
+
+#if DS3231_INCLUDE_INTERVAL_ALARM
+	/**
+	 * @brief The interval alarm start function
+	 *
+	 * Arms alarm 1 for the first multiple of the interval, plus the phase, after the current time, clears its flag and enables its interrupt, in one read and one write.
+	 * Please note that it does not set the output pin to interrupt, see ds3231_int_sqw_pin_select.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param interval_alarm: pointer to a ds3231_interval_alarm_t struct, its reference_clock member is kept
+	 * @param interval: seconds between fires, e.g. 900 for every 15 minutes
+	 * @param phase: seconds into the interval, counted from 1970-01-01 00:00:00
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_interval_alarm_start(const ds3231_handle_t *handle, ds3231_interval_alarm_t *interval_alarm, const uint32_t interval, const uint32_t phase);
+
+	/**
+	 * @brief The interval alarm re-arm function
+	 *
+	 * Call it when the alarm interrupt fires. Reads the time, alarm, control and status registers in one burst and, if alarm 1 fired, writes the next alarm 1 image and the cleared flag in one burst.
+	 * The re-arm time, the lateness and the missed fires are updated in the interval_alarm struct. A fire before the armed one, which only happens with intervals longer than
+	 * 28 days as the date matches in every month, is re-armed without being reported.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param interval_alarm: pointer to a started ds3231_interval_alarm_t struct
+	 * @param fired: pointer to a ds3231_bool_t variable that returns DS3231_TRUE if the armed fire was reached and alarm 1 was re-armed for the next one
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_interval_alarm_rearm(const ds3231_handle_t *handle, ds3231_interval_alarm_t *interval_alarm, ds3231_bool_t *fired);
+
+	/**
+	 * @brief The interval alarm arm function
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param interval_alarm: pointer to a ds3231_interval_alarm_t struct
+	 * @param start: DS3231_TRUE to arm regardless of the flag and enable the interrupt, DS3231_FALSE to only re-arm after a fire
+	 * @param fired: pointer to a ds3231_bool_t variable that returns DS3231_TRUE if alarm 1 was armed for a new fire
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_interval_alarm_arm(const ds3231_handle_t *handle, ds3231_interval_alarm_t *interval_alarm, const ds3231_bool_t start, ds3231_bool_t *fired);
+#endif
+
+#if DS3231_INCLUDE_CRON_ALARM
+	/**
+	 * @brief The cron compile function
+	 *
+	 * Compiles a cron expression of minute, hour, date, month and day of week, like "*\/5 8-18 * * MON-FRI", into one bitmap per field and the coarsest alarm 2 rate that fires on every match.
+	 * Fields take *, values, ranges, lists and steps, months and days of week also take 3 letter names. Does not access DS3231.
+	 *
+	 * @param expression: the cron expression, a NUL terminated string
+	 * @param cron: pointer to a ds3231_cron_t struct that returns the compiled expression
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_cron_compile(const char *expression, ds3231_cron_t *cron);
+
+	/**
+	 * @brief The cron match function
+	 *
+	 * Checks a time against the bitmaps of a compiled cron expression, the day of week of time_struct is used as is. Does not access DS3231.
+	 *
+	 * @param cron: pointer to a compiled ds3231_cron_t struct
+	 * @param time_struct: pointer to a ds3231_time_and_calendar_t struct, the second is ignored
+	 * @param match: pointer to a ds3231_bool_t variable that returns DS3231_TRUE on a match
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_cron_matches(const ds3231_cron_t *cron, const ds3231_time_and_calendar_t *time_struct, ds3231_bool_t *match);
+
+	/**
+	 * @brief The cron next fire function
+	 *
+	 * Finds the first match of a compiled cron expression after now, searching a day at a time with the bitmaps. Does not access DS3231.
+	 *
+	 * @param cron: pointer to a compiled ds3231_cron_t struct
+	 * @param now: the current time in seconds since 1970-01-01 00:00:00
+	 * @param next_fire: pointer to a ds3231_epoch_t variable that returns the next match
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_cron_next_fire(const ds3231_cron_t *cron, const ds3231_epoch_t now, ds3231_epoch_t *next_fire);
+
+	/**
+	 * @brief The cron start function
+	 *
+	 * Programs alarm 2 for a compiled cron expression, clears its flag and enables its interrupt, in one read and one write.
+	 * Please note that it does not set the output pin to interrupt, see ds3231_int_sqw_pin_select.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param cron: pointer to a compiled ds3231_cron_t struct
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_cron_start(const ds3231_handle_t *handle, const ds3231_cron_t *cron);
+
+	/**
+	 * @brief The cron check function
+	 *
+	 * Call it when the alarm interrupt fires. Reads the time, alarm, control and status registers in one burst and, if alarm 2 fired, clears its flag in one write, together with the next match unless the rate is exact.
+	 * A fire that doesn't match the expression is filtered out, matching the time alarm 2 fired at rather than the time of the check.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param cron: pointer to a compiled ds3231_cron_t struct
+	 * @param due: pointer to a ds3231_bool_t variable that returns DS3231_TRUE if alarm 2 fired on a match
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_cron_check(const ds3231_handle_t *handle, const ds3231_cron_t *cron, ds3231_bool_t *due);
+
+	/**
+	 * @brief The cron arm function
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param cron: pointer to a compiled ds3231_cron_t struct
+	 * @param start: DS3231_TRUE to arm regardless of the flag and enable the interrupt, DS3231_FALSE to only re-arm after a fire
+	 * @param due: pointer to a ds3231_bool_t variable that returns DS3231_TRUE if alarm 2 fired on a match
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_cron_arm(const ds3231_handle_t *handle, const ds3231_cron_t *cron, const ds3231_bool_t start, ds3231_bool_t *due);
+
+	/**
+	 * @brief The cron last fire function
+	 *
+	 * Finds the last time at or before now that alarm 2, as programmed in its registers, matched. Does not access DS3231.
+	 *
+	 * @param data: pointer to the 3 alarm 2 registers
+	 * @param now: the current time in seconds since 1970-01-01 00:00:00
+	 * @param last_fire: pointer to a ds3231_epoch_t variable that returns the fire, or the start of the current minute if there was none within a period of the rate
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_cron_last_fire(const uint8_t *data, const ds3231_epoch_t now, ds3231_epoch_t *last_fire);
+
+	/**
+	 * @brief The cron field parse function
+	 *
+	 * Parses a comma separated list of *, values, ranges and steps into a bitmap, and moves the cursor after it.
+	 *
+	 * @param cursor: pointer to the parse position in the expression
+	 * @param field: pointer to the ds3231_cron_field_t of the field
+	 * @param bits: pointer to a variable that returns bit n set for each value n of the field
+	 * @param restricted: pointer to a ds3231_bool_t variable that returns DS3231_FALSE if the field starts with *
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_cron_parse_field(const char **cursor, const ds3231_cron_field_t *field, uint64_t *bits, ds3231_bool_t *restricted);
+
+	/**
+	 * @brief The cron value parse function
+	 *
+	 * Parses a number or a 3 letter name within the range of a field, and moves the cursor after it.
+	 *
+	 * @param cursor: pointer to the parse position in the expression
+	 * @param field: pointer to the ds3231_cron_field_t of the field, or NULL for a step without a range
+	 * @param value: pointer to a variable that returns the value
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_cron_parse_value(const char **cursor, const ds3231_cron_field_t *field, uint8_t *value);
+
+	/**
+	 * @brief The cron day match function
+	 *
+	 * @param cron: pointer to a compiled ds3231_cron_t struct
+	 * @param date: the date of the month
+	 * @param month: the month
+	 * @param day: the day of week
+	 * @return Returns DS3231_TRUE if the expression matches on that day
+	 */
+	ds3231_bool_t _ds3231_cron_day_matches(const ds3231_cron_t *cron, const ds3231_date_t date, const ds3231_month_t month, const ds3231_day_t day);
+
+	/**
+	 * @brief The first bit function
+	 *
+	 * @param bits: a bitmap
+	 * @param from: the first bit to look at
+	 * @return Returns the index of the first set bit from the given one, or 64 if there is none
+	 */
+	uint8_t _ds3231_cron_first_bit(const uint64_t bits, const uint8_t from);
+#endif
+
+#if DS3231_INCLUDE_WAKE_PLANNER
+	/**
+	 * @brief The wake planner init function
+	 *
+	 * Clears a wake planner of its tasks and heartbeat. Does not access DS3231.
+	 *
+	 * @param planner: pointer to a ds3231_wake_planner_t struct
+	 */
+	void ds3231_wake_planner_init(ds3231_wake_planner_t *planner);
+
+	/**
+	 * @brief The wake planner add function
+	 *
+	 * Adds a task that runs in the window from tolerance seconds before its deadline to the deadline, once or every period seconds. Does not access DS3231.
+	 * Add the tasks before ds3231_wake_planner_start, the task index is its bit in the due mask of ds3231_wake_planner_service.
+	 *
+	 * @param planner: pointer to a ds3231_wake_planner_t struct
+	 * @param deadline: the first deadline in seconds since 1970-01-01 00:00:00
+	 * @param tolerance: seconds the task may run early
+	 * @param period: seconds between deadlines, 0 for a one shot task
+	 * @param task_index: pointer to a uint8_t variable that returns the index of the task, or NULL
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_wake_planner_add(ds3231_wake_planner_t *planner, const ds3231_epoch_t deadline, const uint32_t tolerance, const uint32_t period, uint8_t *task_index);
+
+	/**
+	 * @brief The wake planner next function
+	 *
+	 * Computes the next wake up after now, which is the heartbeat if it comes first, else the first deadline, where every task whose window has begun is served.
+	 * Waking up at the first deadline, not before, serves the most windows, so each wake up is as late as possible and the number of wake ups is the minimum. Does not access DS3231.
+	 *
+	 * @param planner: pointer to a ds3231_wake_planner_t struct
+	 * @param now: the current time in seconds since 1970-01-01 00:00:00
+	 * @param wake: pointer to a ds3231_epoch_t variable that returns the next wake up, DS3231_WAKE_NEVER if there is none
+	 * @param source: pointer to a ds3231_wake_source_t variable that returns the alarm that fires for it
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_wake_planner_next(const ds3231_wake_planner_t *planner, const ds3231_epoch_t now, ds3231_epoch_t *wake, ds3231_wake_source_t *source);
+
+	/**
+	 * @brief The wake planner estimate function
+	 *
+	 * Runs the plan on a copy of the planner from start for duration seconds, e.g. 86400 for a day, and counts the wake ups after start up to start + duration and the bus bytes of servicing them. Does not access DS3231.
+	 *
+	 * @param planner: pointer to a ds3231_wake_planner_t struct
+	 * @param start: the start of the run in seconds since 1970-01-01 00:00:00
+	 * @param duration: the length of the run in seconds
+	 * @param estimate: pointer to a ds3231_wake_estimate_t struct that returns the counts
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_wake_planner_estimate(const ds3231_wake_planner_t *planner, const ds3231_epoch_t start, const uint32_t duration, ds3231_wake_estimate_t *estimate);
+
+	/**
+	 * @brief The wake planner start function
+	 *
+	 * Programs the heartbeat into alarm 2 and the first wake up into alarm 1, clears their flags and enables their interrupts, in one read and one write.
+	 * Please note that it does not set the output pin to interrupt, see ds3231_int_sqw_pin_select.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param planner: pointer to a ds3231_wake_planner_t struct
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_wake_planner_start(const ds3231_handle_t *handle, ds3231_wake_planner_t *planner);
+
+	/**
+	 * @brief The wake planner service function
+	 *
+	 * Call it on each wake up. Reads the time, alarm, control and status registers in one burst, returns the tasks to run and moves them to their next deadline.
+	 * Then writes the fired flags cleared in one write, together with alarm 1 only if the next wake up changed it.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param planner: pointer to a ds3231_wake_planner_t struct
+	 * @param due: pointer to a uint32_t variable that returns bit n set if task n is to run now
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_wake_planner_service(const ds3231_handle_t *handle, ds3231_wake_planner_t *planner, uint32_t *due);
+
+	/**
+	 * @brief The wake planner arm function
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param planner: pointer to a ds3231_wake_planner_t struct
+	 * @param start: DS3231_TRUE to program both alarms, DS3231_FALSE to serve the due tasks and re-arm alarm 1
+	 * @param due: pointer to a uint32_t variable that returns the due tasks
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_wake_planner_arm(const ds3231_handle_t *handle, ds3231_wake_planner_t *planner, const ds3231_bool_t start, uint32_t *due);
+
+	/**
+	 * @brief The wake planner collect function
+	 *
+	 * Returns the tasks whose window has begun at now and moves them past now to their next deadline, a one shot task to DS3231_WAKE_NEVER.
+	 *
+	 * @param planner: pointer to a ds3231_wake_planner_t struct
+	 * @param now: the time of the wake up in seconds since 1970-01-01 00:00:00
+	 * @return Returns the due mask, bit n for task n
+	 */
+	uint32_t _ds3231_wake_planner_collect(ds3231_wake_planner_t *planner, const ds3231_epoch_t now);
+
+	/**
+	 * @brief The wake planner alarm 1 function
+	 *
+	 * Returns the wake up for alarm 1, the first deadline but at least DS3231_WAKE_MIN_LEAD_S and at most DS3231_WAKE_MAX_SLEEP_S after now.
+	 *
+	 * @param planner: pointer to a ds3231_wake_planner_t struct
+	 * @param now: the current time in seconds since 1970-01-01 00:00:00
+	 * @return Returns the wake up, DS3231_WAKE_NEVER if there are no tasks left
+	 */
+	ds3231_epoch_t _ds3231_wake_planner_alarm_1_wake(const ds3231_wake_planner_t *planner, const ds3231_epoch_t now);
+#endif
+
+#if DS3231_INCLUDE_DEVICE_CONFIG
+	/**
+	 * @brief The apply config function
+	 *
+	 * Brings the alarm, control, status and aging offset registers to the desired state. Reads them in one burst, and writes only the runs of registers that differ,
+	 * two runs with a gap of up to DS3231_I2C_WRITE_OVERHEAD_BYTES merged into one write. When DS3231 is already in the desired state, the read is the only transaction.
+	 * The fields of a masked alarm register are ignored, the alarm flags and the oscillator stop flag are kept.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param config: pointer to a ds3231_device_config_t struct with the desired state
+	 * @param changes: pointer to a ds3231_config_part_mask_t variable that returns a DS3231_CONFIG_ bit for each part written, 0 if none
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_apply_config(const ds3231_handle_t *handle, const ds3231_device_config_t *config, ds3231_config_part_mask_t *changes);
+
+	/**
+	 * @brief The device config encode function
+	 *
+	 * Checks a device config like the alarm init functions do and encodes it into the register image from alarm 1 seconds up to the aging offset,
+	 * with a mask of the bits the config sets in each register. Does not access DS3231.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle, for its runtime policy
+	 * @param config: pointer to a ds3231_device_config_t struct
+	 * @param image: pointer to DS3231_DEVICE_CONFIG_LENGTH bytes that return the register values
+	 * @param care: pointer to DS3231_DEVICE_CONFIG_LENGTH bytes that return the bits of each register set by the config
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_device_config_encode(const ds3231_handle_t *handle, const ds3231_device_config_t *config, uint8_t *image, uint8_t *care);
+
+	/**
+	 * @brief The device config reconcile function
+	 *
+	 * Reads the registers from alarm 1 seconds up to the aging offset, writes the cared bits of image where they differ in coalesced runs, and verifies them in one read back.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param image: pointer to DS3231_DEVICE_CONFIG_LENGTH bytes of desired register values
+	 * @param care: pointer to DS3231_DEVICE_CONFIG_LENGTH bytes of the bits to bring to image, the others are written back as read
+	 * @param changes: pointer to a ds3231_config_part_mask_t variable that returns the parts written
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t _ds3231_device_config_reconcile(const ds3231_handle_t *handle, const uint8_t *image, const uint8_t *care, ds3231_config_part_mask_t *changes);
+
+	/**
+	 * @brief The config save function
+	 *
+	 * Reads the registers from alarm 1 seconds up to the aging offset in one burst into a 12 byte blob, without the flags, and appends their CRC-16.
+	 * The blob is plain data to keep in EEPROM or flash, the same configuration always gives the same blob.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param blob: pointer to a ds3231_config_blob_t struct that returns the blob
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_config_save(const ds3231_handle_t *handle, ds3231_config_blob_t *blob);
+
+	/**
+	 * @brief The config restore function
+	 *
+	 * Checks the CRC-16 of a blob and writes its registers in one burst, e.g. to provision a replaced DS3231. The flags are written as 1, which keeps them.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param blob: pointer to a ds3231_config_blob_t struct from ds3231_config_save
+	 * @return Returns 0 for no error, DS3231_ERROR_CONFIG_BLOB_CRC for a corrupted blob, in which case nothing is written
+	 */
+	ds3231_error_code_t ds3231_config_restore(const ds3231_handle_t *handle, const ds3231_config_blob_t *blob);
+
+	/**
+	 * @brief The config blob CRC function
+	 *
+	 * @param data: pointer to the bytes
+	 * @param number_of_bytes: number of bytes
+	 * @return Returns the CRC-16/CCITT-FALSE of the bytes
+	 */
+	uint16_t _ds3231_config_blob_crc(const uint8_t *data, const uint8_t number_of_bytes);
+#endif
+
+#if DS3231_INCLUDE_TEMPERATURE_MONITOR
+	/**
+	 * @brief The temperature monitor init function
+	 *
+	 * Clears a temperature monitor, with no thresholds, no rate limit and a hysteresis of one degree. Does not access DS3231.
+	 *
+	 * @param monitor: pointer to a ds3231_temperature_monitor_t struct
+	 * @param callback: the function called for each event, or NULL to only poll the active member
+	 * @param context: passed to the callback as is
+	 */
+	void ds3231_temperature_monitor_init(ds3231_temperature_monitor_t *monitor, ds3231_temperature_event_fp callback, void *context);
+
+	/**
+	 * @brief The temperature monitor sample function
+	 *
+	 * Takes a sample, raises or clears the events and returns when to take the next one. While the temperature is stable, the sample is the last conversion
+	 * DS3231 makes by itself every 64 seconds, read in one transaction, and the interval is 64 seconds. While it changes, the interval is halved down to
+	 * DS3231_TEMPERATURE_MONITOR_MIN_INTERVAL_S and each sample forces a conversion. It is doubled back as the change slows down, so the interval settles
+	 * where a sample sees a change of about DS3231_TEMPERATURE_MONITOR_MIN_STEP quarter degrees.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param monitor: pointer to a ds3231_temperature_monitor_t struct
+	 * @param now: the current time in seconds, e.g. an uptime or the epoch of DS3231
+	 * @param interval: pointer to a uint32_t variable that returns the seconds to the next sample
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_temperature_monitor_sample(const ds3231_handle_t *handle, ds3231_temperature_monitor_t *monitor, const ds3231_epoch_t now, uint32_t *interval);
+
+	/**
+	 * @brief The temperature monitor event function
+	 *
+	 * Raises an event that is not active when enter is DS3231_TRUE, or clears an active one when leave is DS3231_TRUE, and calls the callback for it.
+	 *
+	 * @param monitor: pointer to a ds3231_temperature_monitor_t struct
+	 * @param event: the event
+	 * @param enter: DS3231_TRUE if the condition to raise the event is met
+	 * @param leave: DS3231_TRUE if the condition to clear the event is met
+	 */
+	void _ds3231_temperature_monitor_event(ds3231_temperature_monitor_t *monitor, const ds3231_temperature_event_t event, const ds3231_bool_t enter, const ds3231_bool_t leave);
+#endif
+
+#if DS3231_INCLUDE_SAMPLE_STORE
+	/**
+	 * @brief The sample store init function
+	 *
+	 * Empties a sample store. Does not access DS3231.
+	 *
+	 * @param store: pointer to a ds3231_sample_store_t struct
+	 */
+	void ds3231_sample_store_init(ds3231_sample_store_t *store);
+
+	/**
+	 * @brief The sample store append function
+	 *
+	 * Appends a sample in O(1), the oldest samples are dropped to make room when the buffer is full. Does not access DS3231.
+	 * Samples taken at a steady interval with a temperature change of up to 16 degrees take 2 bytes each.
+	 *
+	 * @param store: pointer to a ds3231_sample_store_t struct
+	 * @param time: the time of the sample in seconds
+	 * @param temperature: the temperature in quarter degrees
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_sample_store_append(ds3231_sample_store_t *store, const ds3231_epoch_t time, const int16_t temperature);
+
+#if DS3231_INCLUDE_CALENDAR
+	/**
+	 * @brief The sample store capture function
+	 *
+	 * Reads the time and the temperature of the last conversion DS3231 made by itself in one burst, and appends them as a sample.
+	 *
+	 * @param handle: pointer to a ds3231_handle_t handle
+	 * @param store: pointer to a ds3231_sample_store_t struct
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_sample_store_capture(const ds3231_handle_t *handle, ds3231_sample_store_t *store);
+#endif
+
+	/**
+	 * @brief The sample store first function
+	 *
+	 * Puts a cursor on the oldest sample, to iterate forward with ds3231_sample_store_next. Does not access DS3231.
+	 *
+	 * @param store: pointer to a ds3231_sample_store_t struct
+	 * @param cursor: pointer to a ds3231_sample_cursor_t struct that returns the cursor, its sample member is the oldest sample
+	 * @return Returns 0 for no error, DS3231_ERROR_SAMPLE_STORE_END if the store is empty
+	 */
+	ds3231_error_code_t ds3231_sample_store_first(const ds3231_sample_store_t *store, ds3231_sample_cursor_t *cursor);
+
+	/**
+	 * @brief The sample store next function
+	 *
+	 * Moves a cursor from ds3231_sample_store_first to the next newer sample in O(1). Does not access DS3231.
+	 *
+	 * @param store: pointer to a ds3231_sample_store_t struct
+	 * @param cursor: pointer to a ds3231_sample_cursor_t struct
+	 * @return Returns 0 for no error, DS3231_ERROR_SAMPLE_STORE_END if the cursor was on the newest sample
+	 */
+	ds3231_error_code_t ds3231_sample_store_next(const ds3231_sample_store_t *store, ds3231_sample_cursor_t *cursor);
+
+	/**
+	 * @brief The sample store last function
+	 *
+	 * Puts a cursor on the newest sample, to iterate backward with ds3231_sample_store_previous. Does not access DS3231.
+	 *
+	 * @param store: pointer to a ds3231_sample_store_t struct
+	 * @param cursor: pointer to a ds3231_sample_cursor_t struct that returns the cursor, its sample member is the newest sample
+	 * @return Returns 0 for no error, DS3231_ERROR_SAMPLE_STORE_END if the store is empty
+	 */
+	ds3231_error_code_t ds3231_sample_store_last(const ds3231_sample_store_t *store, ds3231_sample_cursor_t *cursor);
+
+	/**
+	 * @brief The sample store previous function
+	 *
+	 * Moves a cursor from ds3231_sample_store_last to the next older sample in O(1). Does not access DS3231.
+	 *
+	 * @param store: pointer to a ds3231_sample_store_t struct
+	 * @param cursor: pointer to a ds3231_sample_cursor_t struct
+	 * @return Returns 0 for no error, DS3231_ERROR_SAMPLE_STORE_END if the cursor was on the oldest sample
+	 */
+	ds3231_error_code_t ds3231_sample_store_previous(const ds3231_sample_store_t *store, ds3231_sample_cursor_t *cursor);
+
+	/**
+	 * @brief The sample store recent function
+	 *
+	 * Copies the most recent samples, up to number_of_samples, oldest first, decoding only them from the newest one. Does not access DS3231.
+	 *
+	 * @param store: pointer to a ds3231_sample_store_t struct
+	 * @param samples: pointer to an array of number_of_samples ds3231_sample_t structs
+	 * @param number_of_samples: size of the samples array
+	 * @param count: pointer to a uint16_t variable that returns the number of samples copied
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_sample_store_recent(const ds3231_sample_store_t *store, ds3231_sample_t *samples, const uint16_t number_of_samples, uint16_t *count);
+
+	/**
+	 * @brief The sample store record decode function
+	 *
+	 * @param store: pointer to a ds3231_sample_store_t struct
+	 * @param offset: the offset of a record
+	 * @param delta_of_delta: pointer to an int64_t variable that returns the change of the interval
+	 * @param temperature_delta: pointer to an int16_t variable that returns the change of the temperature
+	 * @return Returns the offset after the record
+	 */
+	uint16_t _ds3231_sample_record_decode(const ds3231_sample_store_t *store, uint16_t offset, int64_t *delta_of_delta, int16_t *temperature_delta);
+
+	/**
+	 * @brief The sample store record start function
+	 *
+	 * Finds where the record that ends at the given offset starts, the last byte of each varint is the only one without DS3231_VARINT_CONTINUE.
+	 *
+	 * @param store: pointer to a ds3231_sample_store_t struct
+	 * @param end: the offset after the record
+	 * @return Returns the offset of the record
+	 */
+	uint16_t _ds3231_sample_record_start(const ds3231_sample_store_t *store, uint16_t end);
+
+	/**
+	 * @brief The varint encode function
+	 *
+	 * Writes a signed number zig-zag encoded, 0, -1, 1, -2... as 0, 1, 2, 3..., then 7 bits per byte, least significant first.
+	 *
+	 * @param value: the number
+	 * @param data: pointer to the bytes, up to 10
+	 * @return Returns the number of bytes written
+	 */
+	uint8_t _ds3231_varint_encode(const int64_t value, uint8_t *data);
+#endif
+
+#if DS3231_INCLUDE_SAFE_RANGE_CHECK
+	/**
+	 * @brief The time and calendar validation function
+	 *
+	 * Checks every field of a time struct in a single branch-free pass, including the last date of the month in leap and non-leap years.
+	 * Does not access DS3231. Used internally on both the set and get paths.
+	 *
+	 * @param time_struct: pointer to a ds3231_time_and_calendar_t struct
+	 * @param failing_fields: pointer to a ds3231_field_mask_t variable that returns a DS3231_FIELD_ bit for each field out of range, 0 if valid
+	 * @return Returns 0 for no error
+	 */
+	ds3231_error_code_t ds3231_validate_time_and_calendar(const ds3231_time_and_calendar_t *time_struct, ds3231_field_mask_t *failing_fields);
+
+	/**
+	 * @brief The field range error function
+	 *
+	 * Turns a mask of failing fields into the range error of the first failing field, in register order.
+	 *
+	 * @param failing_fields: a mask of DS3231_FIELD_ bits
+	 * @return Returns the range error, 0 for an empty mask
+	 */
+	ds3231_error_code_t _ds3231_field_range_error(const ds3231_field_mask_t failing_fields);
 #endif
 
 #if DS3231_INCLUDE_NULL_CHECK
@@ -0,0 +1,786 @@
+/**
+ * @file ds3231.hpp
+ * @brief DS3231 Real Time Clock C Driver
+ * @author Reza G. Ebrahimi <https://github.com/ebrezadev>
+ * @version 2.0
+ * @license MIT
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Reza G. Ebrahimi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef __DS3231_HPP__
+#define __DS3231_HPP__
+
+#include "ds3231.h"
+
+namespace ds3231
+{
+	namespace policy
+	{
+		/**
+		 * @brief Range check policy. Enabled, every time struct is validated before it is written and after it is read.
+		 *
+		 */
+		template <bool Enabled>
+		struct range_check
+		{
+			static constexpr bool enabled = Enabled;
+		};
+
+		/**
+		 * @brief Write verification policy. Enabled, every write is read back and compared.
+		 *
+		 */
+		template <bool Enabled>
+		struct verification
+		{
+			static constexpr bool enabled = Enabled;
+		};
+
+		/**
+		 * @brief Connection check policy. Enabled, the I2C ACK of DS3231 is tested before each API call.
+		 *
+		 */
+		template <bool Enabled>
+		struct connection_check
+		{
+			static constexpr bool enabled = Enabled;
+		};
+
+		/**
+		 * @brief NULL check policy. Enabled, the handle and interface function pointers are checked before each API call.
+		 *
+		 */
+		template <bool Enabled>
+		struct null_check
+		{
+			static constexpr bool enabled = Enabled;
+		};
+
+		/**
+		 * @brief Locking policy. Enabled, every bus transaction is protected with the lock and unlock hooks of the handle.
+		 *
+		 */
+		template <bool Enabled>
+		struct locking
+		{
+			static constexpr bool enabled = Enabled;
+		};
+	}
+
+	/**
+	 * @brief The DS3231 wrapper
+	 *
+	 * A header-only wrapper over a ds3231_handle_t, with the safety features chosen per instantiation instead of globally in ds3231_config.h.
+	 * Disabled policies are removed at compile time. Enabling a policy requires the matching feature in ds3231_config.h, since it uses its error codes.
+	 * The policies apply to the time and calendar, the control and status bits, the aging offset, the temperature and the alarm setup.
+	 * The defaults follow ds3231_config.h. Everything else, e.g. the alarm flags, can be reached through handle() and the C API, under the policies of ds3231_config.h.
+	 *
+	 */
+	template <
+		class RangeCheck = policy::range_check<DS3231_INCLUDE_SAFE_RANGE_CHECK>,
+		class Verification = policy::verification<DS3231_INCLUDE_WRITE_VERIFICATION>,
+		class ConnectionCheck = policy::connection_check<DS3231_INCLUDE_CONNECTION_CHECK>,
+		class NullCheck = policy::null_check<DS3231_INCLUDE_NULL_CHECK>,
+		class Locking = policy::locking<DS3231_INCLUDE_EXCLUSION_HOOK>>
+	class rtc
+	{
+	public:
+		/**
+		 * @brief The constructor
+		 *
+		 * @param handle: pointer to a handle of DS3231, already initialized with ds3231_init
+		 */
+		explicit rtc(const ds3231_handle_t *handle) : handle_(handle) {}
+
+		/**
+		 * @brief The handle accessor
+		 *
+		 * @return Returns the wrapped handle, to be used with the C API
+		 */
+		const ds3231_handle_t *handle() const { return handle_; }
+
+		/**
+		 * @brief The get all time and calendar function
+		 *
+		 * Reads all the time and calendar registers, including the century bit, in a single burst.
+		 *
+		 * @param time_struct: reference to a ds3231_time_and_calendar_t struct, left untouched on error
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t get_all_time_and_calendar(ds3231_time_and_calendar_t &time_struct) const
+		{
+			ds3231_error_code_t error = check_handle_and_connection();
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			uint8_t data[DS3231_NUMBER_OF_TIME_REGISTERS];
+			error = read(DS3231_REGISTER_SECONDS, data, DS3231_NUMBER_OF_TIME_REGISTERS);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			/*The century bit comes with the burst, no separate read*/
+			bool century_bit = (data[DS3231_MONTH] >> DS3231_BIT_CENTURY) & 1;
+
+			_ds3231_time_block_bcd_to_hex(data);
+
+			ds3231_time_and_calendar_t time_read;
+			time_read.second = data[DS3231_SECONDS];
+			time_read.minute = data[DS3231_MINUTES];
+			time_read.hour = data[DS3231_HOURS];
+			time_read.day = (ds3231_day_t)data[DS3231_DAY];
+			time_read.date = data[DS3231_DATE];
+			time_read.month = (ds3231_month_t)data[DS3231_MONTH];
+			time_read.year = (ds3231_year_t)(data[DS3231_YEAR] + (century_bit ? 1900 : 2000));
+
+			error = check_range(time_read);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			time_struct = time_read;
+
+			return DS3231_ERROR_OK;
+		}
+
+		/**
+		 * @brief The set all time and calendar function
+		 *
+		 * Writes all the time and calendar registers, including the century bit, in a single burst.
+		 * Unlike the C API there is no read-modify-write, since the driver always keeps the hours in 24H format.
+		 *
+		 * @param time_struct: reference to a ds3231_time_and_calendar_t struct, not modified
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t set_all_time_and_calendar(const ds3231_time_and_calendar_t &time_struct) const
+		{
+			ds3231_error_code_t error = check_handle_and_connection();
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			error = check_range(time_struct);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			bool century_bit = time_struct.year < 2000;
+
+			uint8_t data[DS3231_NUMBER_OF_TIME_REGISTERS];
+			data[DS3231_SECONDS] = (uint8_t)time_struct.second;
+			data[DS3231_MINUTES] = (uint8_t)time_struct.minute;
+			data[DS3231_HOURS] = (uint8_t)time_struct.hour;
+			data[DS3231_DAY] = (uint8_t)time_struct.day;
+			data[DS3231_DATE] = (uint8_t)time_struct.date;
+			data[DS3231_MONTH] = (uint8_t)time_struct.month;
+			data[DS3231_YEAR] = (uint8_t)(time_struct.year - (century_bit ? 1900 : 2000));
+
+			_ds3231_time_block_hex_to_bcd(data);
+
+			/*The 12/24 bit stays 0 for 24H format, the century bit is folded into the month*/
+			data[DS3231_MONTH] |= (uint8_t)(century_bit << DS3231_BIT_CENTURY);
+
+			error = write(DS3231_REGISTER_SECONDS, data, DS3231_NUMBER_OF_TIME_REGISTERS);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			return verify(DS3231_REGISTER_SECONDS, data, DS3231_NUMBER_OF_TIME_REGISTERS);
+		}
+
+		/**
+		 * @brief The battery backed oscillator control function
+		 *
+		 * @param enable: DS3231_TRUE sets EOSC, the oscillator stops on battery power
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t battery_backed_oscillator_control(const ds3231_bool_t enable) const
+		{
+			return update_bits(DS3231_REGISTER_CONTROL, (uint8_t)(1 << DS3231_BIT_EOSC), (uint8_t)(enable << DS3231_BIT_EOSC));
+		}
+
+		/**
+		 * @brief The battery backed square wave control function
+		 *
+		 * @param enable: DS3231_TRUE sets BBSQW, the square wave keeps running on battery power
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t battery_backed_sqw_control(const ds3231_bool_t enable) const
+		{
+			return update_bits(DS3231_REGISTER_CONTROL, (uint8_t)(1 << DS3231_BIT_BBSQW), (uint8_t)(enable << DS3231_BIT_BBSQW));
+		}
+
+		/**
+		 * @brief The 32kHz wave control function
+		 *
+		 * @param enable: DS3231_TRUE turns the 32kHz output on
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t wave_32khz_control(const ds3231_bool_t enable) const
+		{
+			return update_bits(DS3231_REGISTER_CONTROL_STATUS, (uint8_t)(1 << DS3231_BIT_EN32KHZ), (uint8_t)(enable << DS3231_BIT_EN32KHZ));
+		}
+
+		/**
+		 * @brief The INT/SQW pin select function
+		 *
+		 * @param output_pin: the alarm interrupt or the square wave
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t int_sqw_pin_select(const ds3231_int_sqw_pin_t output_pin) const
+		{
+			return update_bits(DS3231_REGISTER_CONTROL, (uint8_t)(1 << DS3231_BIT_INTCN), (uint8_t)(output_pin << DS3231_BIT_INTCN));
+		}
+
+		/**
+		 * @brief The square wave frequency function
+		 *
+		 * Writes RS1 and RS2 together, in one read-modify-write.
+		 *
+		 * @param wave_freq: the square wave frequency
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t sqw_output_wave_frequency(const ds3231_sqw_output_wave_frequency_t wave_freq) const
+		{
+			return update_bits(DS3231_REGISTER_CONTROL, (uint8_t)((1 << DS3231_BIT_RS2) | (1 << DS3231_BIT_RS1)), (uint8_t)((wave_freq & 3) << DS3231_BIT_RS1));
+		}
+
+#if DS3231_INCLUDE_AGING_OFFSET_CALIBRATION
+		/**
+		 * @brief The aging offset calibration function
+		 *
+		 * @param offset: the aging offset, about 0.1 ppm per LSB, positive slows the oscillator down
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t aging_offset_calibration(const int8_t offset) const
+		{
+			ds3231_error_code_t error = check_handle_and_connection();
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			uint8_t data = (uint8_t)offset;
+
+			error = write(DS3231_REGISTER_AGING_OFFSET, &data, 1);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			return verify(DS3231_REGISTER_AGING_OFFSET, &data, 1);
+		}
+
+		/**
+		 * @brief The get aging offset function
+		 *
+		 * @param offset: reference to an int8_t variable, left untouched on error
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t get_aging_offset(int8_t &offset) const
+		{
+			ds3231_error_code_t error = check_handle_and_connection();
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			uint8_t data;
+
+			error = read(DS3231_REGISTER_AGING_OFFSET, &data, 1);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			offset = (int8_t)data;
+
+			return DS3231_ERROR_OK;
+		}
+#endif
+
+#if DS3231_INCLUDE_TEMPERATURE
+		/**
+		 * @brief The get temperature raw function
+		 *
+		 * Forces a conversion and reads the temperature, as ds3231_get_temperature_raw.
+		 * CONV clears itself when the conversion is done, so it is not read back.
+		 *
+		 * @param raw: reference to an int16_t variable that returns quarter degrees, left untouched on error
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t get_temperature_raw(int16_t &raw) const
+		{
+			ds3231_error_code_t error = check_handle_and_connection();
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			error = wait_not_busy(DS3231_ERROR_TEMPERATURE_BUSY_TIMEOUT);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			error = modify_bits(DS3231_REGISTER_CONTROL, (uint8_t)(1 << DS3231_BIT_CONV), (uint8_t)(1 << DS3231_BIT_CONV));
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			error = wait_not_busy(DS3231_ERROR_TEMPERATURE_CONVERSION_TIMEOUT);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			uint8_t data[2];
+
+			error = read(DS3231_REGISTER_TEMP_MSB, data, 2);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			raw = _ds3231_temperature_raw(data);
+
+			return DS3231_ERROR_OK;
+		}
+#endif
+
+#if DS3231_INCLUDE_ALARM_1
+		/**
+		 * @brief The alarm 1 init function
+		 *
+		 * Writes the 4 alarm 1 registers in a single burst. The fields matched by the rate are range checked.
+		 *
+		 * @param config: reference to a ds3231_alarm_1_config_t struct
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t alarm_1_init(const ds3231_alarm_1_config_t &config) const
+		{
+			ds3231_error_code_t error = check_handle_and_connection();
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			if (((config.day_date_type == DS3231_ALARM_DAY) && (config.alarm_rate == DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR_DATE)) ||
+				((config.day_date_type == DS3231_ALARM_DATE) && (config.alarm_rate == DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR_DAY)))
+			{
+				return DS3231_ERROR_ALARM_RATE_AND_DAY_DATE_MISMATCH;
+			}
+
+			const uint8_t *mask = DS3231_ALARM_1_MASK_BITS[(int)config.alarm_rate];
+			const uint8_t values[] = {(uint8_t)config.second, (uint8_t)config.minute, (uint8_t)config.hour,
+									  (config.day_date_type == DS3231_ALARM_DAY) ? (uint8_t)config.day_date.day : (uint8_t)config.day_date.date};
+			const ds3231_time_register_t fields[] = {DS3231_SECONDS, DS3231_MINUTES, DS3231_HOURS, (config.day_date_type == DS3231_ALARM_DAY) ? DS3231_DAY : DS3231_DATE};
+
+			for (uint8_t index = 0; index < DS3231_NUMBER_OF_ALARM_1_REGISTERS; index++)
+			{
+				error = (mask[index] == 0) ? check_value(values[index], fields[index]) : DS3231_ERROR_OK;
+				if (error != DS3231_ERROR_OK)
+				{
+					return error;
+				}
+			}
+
+			uint8_t data[DS3231_NUMBER_OF_ALARM_1_REGISTERS];
+			_ds3231_alarm_1_encode(&config, data);
+
+			error = write(DS3231_REGISTER_ALARM1_SECONDS, data, DS3231_NUMBER_OF_ALARM_1_REGISTERS);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			return verify(DS3231_REGISTER_ALARM1_SECONDS, data, DS3231_NUMBER_OF_ALARM_1_REGISTERS);
+		}
+
+		/**
+		 * @brief The alarm 1 interrupt control function
+		 *
+		 * @param enable: DS3231_TRUE sets A1IE
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t alarm_1_interrupt_control(const ds3231_bool_t enable) const
+		{
+			return update_bits(DS3231_REGISTER_CONTROL, (uint8_t)(1 << DS3231_BIT_A1IE), (uint8_t)(enable << DS3231_BIT_A1IE));
+		}
+#endif
+
+#if DS3231_INCLUDE_ALARM_2
+		/**
+		 * @brief The alarm 2 init function
+		 *
+		 * Writes the 3 alarm 2 registers in a single burst. The fields matched by the rate are range checked.
+		 *
+		 * @param config: reference to a ds3231_alarm_2_config_t struct
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t alarm_2_init(const ds3231_alarm_2_config_t &config) const
+		{
+			ds3231_error_code_t error = check_handle_and_connection();
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			if (((config.day_date_type == DS3231_ALARM_DAY) && (config.alarm_rate == DS3231_ALARM2_MATCH_MINUTE_HOUR_DATE)) ||
+				((config.day_date_type == DS3231_ALARM_DATE) && (config.alarm_rate == DS3231_ALARM2_MATCH_MINUTE_HOUR_DAY)))
+			{
+				return DS3231_ERROR_ALARM_RATE_AND_DAY_DATE_MISMATCH;
+			}
+
+			const uint8_t *mask = DS3231_ALARM_2_MASK_BITS[(int)config.alarm_rate];
+			const uint8_t values[] = {(uint8_t)config.minute, (uint8_t)config.hour,
+									  (config.day_date_type == DS3231_ALARM_DAY) ? (uint8_t)config.day_date.day : (uint8_t)config.day_date.date};
+			const ds3231_time_register_t fields[] = {DS3231_MINUTES, DS3231_HOURS, (config.day_date_type == DS3231_ALARM_DAY) ? DS3231_DAY : DS3231_DATE};
+
+			for (uint8_t index = 0; index < DS3231_NUMBER_OF_ALARM_2_REGISTERS; index++)
+			{
+				error = (mask[index] == 0) ? check_value(values[index], fields[index]) : DS3231_ERROR_OK;
+				if (error != DS3231_ERROR_OK)
+				{
+					return error;
+				}
+			}
+
+			uint8_t data[DS3231_NUMBER_OF_ALARM_2_REGISTERS];
+			_ds3231_alarm_2_encode(&config, data);
+
+			error = write(DS3231_REGISTER_ALARM2_MINUTES, data, DS3231_NUMBER_OF_ALARM_2_REGISTERS);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			return verify(DS3231_REGISTER_ALARM2_MINUTES, data, DS3231_NUMBER_OF_ALARM_2_REGISTERS);
+		}
+
+		/**
+		 * @brief The alarm 2 interrupt control function
+		 *
+		 * @param enable: DS3231_TRUE sets A2IE
+		 * @return Returns 0 for no error
+		 */
+		ds3231_error_code_t alarm_2_interrupt_control(const ds3231_bool_t enable) const
+		{
+			return update_bits(DS3231_REGISTER_CONTROL, (uint8_t)(1 << DS3231_BIT_A2IE), (uint8_t)(enable << DS3231_BIT_A2IE));
+		}
+#endif
+
+	private:
+		const ds3231_handle_t *handle_;
+
+		ds3231_error_code_t check_handle_and_connection() const
+		{
+			if constexpr (NullCheck::enabled)
+			{
+#if DS3231_INCLUDE_NULL_CHECK
+				ds3231_error_code_t error = _ds3231_null_check(handle_);
+				if (error != DS3231_ERROR_OK)
+				{
+					return error;
+				}
+#else
+				static_assert(!NullCheck::enabled, "null_check policy requires DS3231_INCLUDE_NULL_CHECK");
+#endif
+			}
+
+			if constexpr (ConnectionCheck::enabled)
+			{
+#if DS3231_INCLUDE_CONNECTION_CHECK
+				ds3231_error_code_t error = lock();
+				if (error != DS3231_ERROR_OK)
+				{
+					return error;
+				}
+
+				int ack = handle_->interface.interface_ack_test((uint8_t)handle_->i2c_address);
+
+				error = unlock();
+				if (error != DS3231_ERROR_OK)
+				{
+					return error;
+				}
+
+				if (ack != 0)
+				{
+					return DS3231_ERROR_DS3231_NOT_CONNECTED;
+				}
+#else
+				static_assert(!ConnectionCheck::enabled, "connection_check policy requires DS3231_INCLUDE_CONNECTION_CHECK");
+#endif
+			}
+
+			return DS3231_ERROR_OK;
+		}
+
+		ds3231_error_code_t check_range(const ds3231_time_and_calendar_t &time_struct) const
+		{
+			if constexpr (RangeCheck::enabled)
+			{
+#if DS3231_INCLUDE_SAFE_RANGE_CHECK
+				ds3231_field_mask_t failing_fields;
+				ds3231_validate_time_and_calendar(&time_struct, &failing_fields);
+				if (failing_fields != 0)
+				{
+					return _ds3231_field_range_error(failing_fields);
+				}
+#else
+				static_assert(!RangeCheck::enabled, "range_check policy requires DS3231_INCLUDE_SAFE_RANGE_CHECK");
+#endif
+			}
+			(void)time_struct;
+
+			return DS3231_ERROR_OK;
+		}
+
+		ds3231_error_code_t check_value(const uint8_t value, const ds3231_time_register_t field) const
+		{
+			if constexpr (RangeCheck::enabled)
+			{
+#if DS3231_INCLUDE_SAFE_RANGE_CHECK
+				if ((value < DS3231_MASK_AND_RANGE_LUT[field].range_min) || (value > DS3231_MASK_AND_RANGE_LUT[field].range_max))
+				{
+					return DS3231_MASK_AND_RANGE_LUT[field].error;
+				}
+#else
+				static_assert(!RangeCheck::enabled, "range_check policy requires DS3231_INCLUDE_SAFE_RANGE_CHECK");
+#endif
+			}
+			(void)value;
+			(void)field;
+
+			return DS3231_ERROR_OK;
+		}
+
+		/*Reads a register, replaces the bits under mask and writes it back. The alarm flags and OSF are written as 1, which leaves them as they are*/
+		ds3231_error_code_t modify_bits(const ds3231_register_address_t register_address, const uint8_t mask, const uint8_t value) const
+		{
+			uint8_t data;
+
+			ds3231_error_code_t error = read(register_address, &data, 1);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			data = (uint8_t)((data & ~mask) | (value & mask));
+			if (register_address == DS3231_REGISTER_CONTROL_STATUS)
+			{
+				data |= (uint8_t)((1 << DS3231_BIT_OSF) | (1 << DS3231_BIT_A2F) | (1 << DS3231_BIT_A1F));
+			}
+
+			return write(register_address, &data, 1);
+		}
+
+		ds3231_error_code_t update_bits(const ds3231_register_address_t register_address, const uint8_t mask, const uint8_t value) const
+		{
+			ds3231_error_code_t error = check_handle_and_connection();
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			error = modify_bits(register_address, mask, value);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			/*Only the bits written on purpose are compared, the flags and CONV change by themselves*/
+			if constexpr (Verification::enabled)
+			{
+#if DS3231_INCLUDE_WRITE_VERIFICATION
+				uint8_t data;
+
+				error = read(register_address, &data, 1);
+				if (error != DS3231_ERROR_OK)
+				{
+					return error;
+				}
+
+				if ((data & mask) != (value & mask))
+				{
+					return DS3231_ERROR_VERIFICATION_FAIL;
+				}
+#else
+				static_assert(!Verification::enabled, "verification policy requires DS3231_INCLUDE_WRITE_VERIFICATION");
+#endif
+			}
+
+			return DS3231_ERROR_OK;
+		}
+
+#if DS3231_INCLUDE_TEMPERATURE
+		ds3231_error_code_t wait_not_busy(const ds3231_error_code_t timeout_error) const
+		{
+			for (uint32_t timeout = DS3231_TEMPERATURE_READ_TIMEOUT; timeout > DS3231_TEMPERATURE_READ_DELAY; timeout -= DS3231_TEMPERATURE_READ_DELAY)
+			{
+				uint8_t data;
+
+				handle_->interface.delay_function(DS3231_TEMPERATURE_READ_DELAY);
+
+				ds3231_error_code_t error = read(DS3231_REGISTER_CONTROL_STATUS, &data, 1);
+				if (error != DS3231_ERROR_OK)
+				{
+					return error;
+				}
+
+				if (((data >> DS3231_BIT_BSY) & 1) == 0)
+				{
+					return DS3231_ERROR_OK;
+				}
+			}
+
+			return timeout_error;
+		}
+#endif
+
+		ds3231_error_code_t lock() const
+		{
+			if constexpr (Locking::enabled)
+			{
+#if DS3231_INCLUDE_EXCLUSION_HOOK
+				if (handle_->interface.interface_exclusion.interface_lock((void *)handle_->interface.interface_exclusion.mutex_handle) != 0)
+				{
+					return DS3231_ERROR_INTERFACE_MUTEX_LOCK;
+				}
+#else
+				static_assert(!Locking::enabled, "locking policy requires DS3231_INCLUDE_EXCLUSION_HOOK");
+#endif
+			}
+
+			return DS3231_ERROR_OK;
+		}
+
+		ds3231_error_code_t unlock() const
+		{
+			if constexpr (Locking::enabled)
+			{
+#if DS3231_INCLUDE_EXCLUSION_HOOK
+				if (handle_->interface.interface_exclusion.interface_unlock((void *)handle_->interface.interface_exclusion.mutex_handle) != 0)
+				{
+					return DS3231_ERROR_INTERFACE_MUTEX_UNLOCK;
+				}
+#endif
+			}
+
+			return DS3231_ERROR_OK;
+		}
+
+		ds3231_error_code_t read(const ds3231_register_address_t register_address, uint8_t *data, const uint8_t length) const
+		{
+			ds3231_error_code_t error = lock();
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			int result = handle_->interface.read_array((uint8_t)handle_->i2c_address, (uint8_t)register_address, data, length);
+
+			error = unlock();
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			return (result != 0) ? DS3231_ERROR_INTERFACE_READ : DS3231_ERROR_OK;
+		}
+
+		ds3231_error_code_t write(const ds3231_register_address_t register_address, uint8_t *data, const uint8_t length) const
+		{
+			ds3231_error_code_t error = lock();
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			int result = handle_->interface.write_array((uint8_t)handle_->i2c_address, (uint8_t)register_address, data, length);
+
+			error = unlock();
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			return (result != 0) ? DS3231_ERROR_INTERFACE_WRITE : DS3231_ERROR_OK;
+		}
+
+		ds3231_error_code_t verify(const ds3231_register_address_t register_address, const uint8_t *expected, const uint8_t length) const
+		{
+			if constexpr (Verification::enabled)
+			{
+#if DS3231_INCLUDE_WRITE_VERIFICATION
+				uint8_t data[DS3231_NUMBER_OF_TIME_REGISTERS];
+
+				ds3231_error_code_t error = read(register_address, data, length);
+				if (error != DS3231_ERROR_OK)
+				{
+					return error;
+				}
+
+				for (uint8_t index = 0; index < length; index++)
+				{
+					if (data[index] != expected[index])
+					{
+						return DS3231_ERROR_VERIFICATION_FAIL;
+					}
+				}
+#else
+				static_assert(!Verification::enabled, "verification policy requires DS3231_INCLUDE_WRITE_VERIFICATION");
+#endif
+			}
+			(void)register_address;
+			(void)expected;
+			(void)length;
+
+			return DS3231_ERROR_OK;
+		}
+	};
+
+	/**
+	 * @brief A wrapper with every safety policy on, for provisioning and debugging.
+	 *
+	 */
+	using safe_rtc = rtc<policy::range_check<true>, policy::verification<true>, policy::connection_check<true>, policy::null_check<true>, policy::locking<DS3231_INCLUDE_EXCLUSION_HOOK>>;
+
+	/**
+	 * @brief A wrapper with every check off, for hot loops. Locking still follows ds3231_config.h, since it protects a shared bus.
+	 *
+	 */
+	using fast_rtc = rtc<policy::range_check<false>, policy::verification<false>, policy::connection_check<false>, policy::null_check<false>, policy::locking<DS3231_INCLUDE_EXCLUSION_HOOK>>;
+}
+
+#endif
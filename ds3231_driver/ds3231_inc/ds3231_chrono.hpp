@@ -0,0 +1,261 @@
+/**
+ * @file ds3231_chrono.hpp
+ * @brief DS3231 Real Time Clock C Driver
+ * @author Reza G. Ebrahimi <https://github.com/ebrezadev>
+ * @version 2.0
+ * @license MIT
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Reza G. Ebrahimi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef __DS3231_CHRONO_HPP__
+#define __DS3231_CHRONO_HPP__
+
+#include <chrono>
+#include <mutex>
+
+#include "ds3231.hpp"
+
+#if DS3231_INCLUDE_CALENDAR & DS3231_INCLUDE_TIME_SYNC
+
+namespace ds3231
+{
+	/**
+	 * @brief A std::chrono clock backed by the DS3231
+	 *
+	 * now() does not touch the I2C bus on every call. bind() and sync() locate the seconds edge of the RTC with ds3231_measure_phase, outside the lock, so now() keeps answering from
+	 * the previous base meanwhile, and the edge is extrapolated with std::chrono::steady_clock. Every resync interval, now() makes a single lean burst read to check the extrapolation:
+	 * a reading only proves the RTC is within its second, so the base is moved by the least amount that brings the extrapolation back into it, and a steady extrapolation is never moved.
+	 * A failed resync keeps extrapolating the last good reading. now() never searches the edge itself, a failed bind is retried with sync().
+	 * The time points never go backwards. They share the epoch and the duration of std::chrono::system_clock, so they can be passed to system_clock::to_time_t and the like with no conversion.
+	 *
+	 */
+	class clock
+	{
+	public:
+		using duration = std::chrono::system_clock::duration;
+		using rep = duration::rep;
+		using period = duration::period;
+		using time_point = std::chrono::time_point<std::chrono::system_clock, duration>;
+
+		/*The RTC can be set at any time*/
+		static constexpr bool is_steady = false;
+
+		/**
+		 * @brief The bind function
+		 *
+		 * Binds the clock to a DS3231 and finds its seconds edge within a millisecond, which blocks for a few seconds.
+		 *
+		 * @param handle: pointer to a handle of DS3231, already initialized with ds3231_init. It must outlive the clock usage
+		 * @param resync_interval: the time between two RTC readings
+		 * @return Returns 0 for no error
+		 */
+		static ds3231_error_code_t bind(const ds3231_handle_t *handle, std::chrono::steady_clock::duration resync_interval = std::chrono::minutes(1))
+		{
+			{
+				std::lock_guard<std::mutex> lock(state_mutex_);
+
+				handle_ = handle;
+				resync_interval_ = resync_interval;
+				synced_ = false;
+			}
+
+			return sync();
+		}
+
+		/**
+		 * @brief The sync function
+		 *
+		 * Finds the seconds edge of the DS3231 again instead of waiting for the resync interval, e.g. after the RTC has been set or a failed bind. Blocks for a few seconds,
+		 * without holding the lock of now().
+		 *
+		 * @return Returns 0 for no error
+		 */
+		static ds3231_error_code_t sync()
+		{
+			const ds3231_handle_t *handle;
+			time_point rtc_base;
+			std::chrono::steady_clock::time_point steady_base;
+
+			{
+				std::lock_guard<std::mutex> lock(state_mutex_);
+
+				handle = handle_;
+			}
+
+			ds3231_error_code_t error = find_edge(handle, rtc_base, steady_base);
+
+			std::lock_guard<std::mutex> lock(state_mutex_);
+
+			/*Only the handle the search ran on is swapped in, a bind meanwhile wins*/
+			if ((error == DS3231_ERROR_OK) && (handle == handle_))
+			{
+				rtc_base_ = rtc_base;
+				steady_base_ = steady_base;
+				synced_ = true;
+				next_sync_ = std::chrono::steady_clock::now() + resync_interval_;
+			}
+
+			return error;
+		}
+
+		/**
+		 * @brief The now function
+		 *
+		 * @return Returns the current time. Before the first successful bind or sync, the system_clock epoch is returned
+		 */
+		static time_point now()
+		{
+			std::lock_guard<std::mutex> lock(state_mutex_);
+
+			std::chrono::steady_clock::time_point steady_now = std::chrono::steady_clock::now();
+
+			/*An unsynced clock doesn't touch the bus at all*/
+			if (synced_ && (steady_now >= next_sync_))
+			{
+				(void)resync_locked();
+				steady_now = std::chrono::steady_clock::now();
+			}
+
+			if (synced_)
+			{
+				time_point extrapolated = rtc_base_ + std::chrono::duration_cast<duration>(steady_now - steady_base_);
+				if (extrapolated > last_)
+				{
+					last_ = extrapolated;
+				}
+			}
+
+			return last_;
+		}
+
+	private:
+		static inline std::mutex state_mutex_;
+		static inline const ds3231_handle_t *handle_ = nullptr;
+		static inline std::chrono::steady_clock::duration resync_interval_ = std::chrono::minutes(1);
+		static inline bool synced_ = false;
+		static inline time_point rtc_base_{};
+		static inline std::chrono::steady_clock::time_point steady_base_{};
+		static inline std::chrono::steady_clock::time_point next_sync_{};
+		static inline time_point last_{};
+
+		/*The edge is located within this, a few seconds of sparse single register reads*/
+		static constexpr int64_t edge_uncertainty_ns_ = 1000000;
+
+		static int64_t steady_ns()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		static ds3231_error_code_t read(const ds3231_handle_t *handle, time_point &rtc_time, std::chrono::steady_clock::time_point &before, std::chrono::steady_clock::time_point &after)
+		{
+			ds3231_time_and_calendar_t time_struct;
+			ds3231_epoch_t epoch;
+
+			if (handle == nullptr)
+			{
+				return DS3231_ERROR_DS3231_NOT_CONNECTED;
+			}
+
+			/*The handle was checked by the edge search, the resync is one burst read*/
+			before = std::chrono::steady_clock::now();
+			ds3231_error_code_t error = fast_rtc(handle).get_all_time_and_calendar(time_struct);
+			after = std::chrono::steady_clock::now();
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			error = ds3231_time_and_calendar_to_epoch(&time_struct, &epoch);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			rtc_time = time_point(std::chrono::duration_cast<duration>(std::chrono::seconds(epoch)));
+
+			return DS3231_ERROR_OK;
+		}
+
+		static ds3231_error_code_t find_edge(const ds3231_handle_t *handle, time_point &rtc_base, std::chrono::steady_clock::time_point &steady_base)
+		{
+			ds3231_phase_t phase;
+
+			if (handle == nullptr)
+			{
+				return DS3231_ERROR_DS3231_NOT_CONNECTED;
+			}
+
+			ds3231_error_code_t error = ds3231_measure_phase(handle, steady_ns, edge_uncertainty_ns_, &phase);
+			if (error == DS3231_ERROR_OK)
+			{
+				rtc_base = time_point(std::chrono::duration_cast<duration>(std::chrono::seconds(phase.rtc_epoch)));
+				steady_base = std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(phase.edge_ns)));
+				return DS3231_ERROR_OK;
+			}
+			if (error != DS3231_ERROR_SYNC_EDGE_TIMEOUT)
+			{
+				return error;
+			}
+
+			/*A stopped oscillator has no edge, its reading is taken as is*/
+			std::chrono::steady_clock::time_point before;
+
+			return read(handle, rtc_base, before, steady_base);
+		}
+
+		static ds3231_error_code_t resync_locked()
+		{
+			time_point reading;
+			std::chrono::steady_clock::time_point before;
+			std::chrono::steady_clock::time_point after;
+
+			next_sync_ = std::chrono::steady_clock::now() + resync_interval_;
+
+			ds3231_error_code_t error = read(handle_, reading, before, after);
+			if (error != DS3231_ERROR_OK)
+			{
+				return error;
+			}
+
+			/*The RTC is at least at the reading by the end of the read, and not yet a second past it at its start*/
+			time_point at_after = rtc_base_ + std::chrono::duration_cast<duration>(after - steady_base_);
+			time_point at_before = rtc_base_ + std::chrono::duration_cast<duration>(before - steady_base_);
+
+			if (at_after < reading)
+			{
+				rtc_base_ += reading - at_after;
+			}
+			else if (at_before >= reading + std::chrono::seconds(1))
+			{
+				rtc_base_ -= at_before - (reading + std::chrono::seconds(1));
+			}
+
+			return DS3231_ERROR_OK;
+		}
+	};
+}
+
+#endif
+
+#endif
@@ -66,6 +66,32 @@ extern "C" {
 #define DS3231_INCLUDE_AGING_OFFSET_CALIBRATION 1
 /*Feature: turn the error log strings on or off*/
 #define DS3231_INCLUDE_ERROR_LOG_STRINGS 1
+/*Feature: turn the calendar (day of week and epoch) conversions on or off*/
+#define DS3231_INCLUDE_CALENDAR 1
+/*Feature: convert the time block BCD with 64 bit SWAR arithmetic (1) or with byte lookup tables (0), use 0 on 8 bit MCUs. Can be set from the compiler command line*/
+#ifndef DS3231_INCLUDE_BCD_SWAR
+#define DS3231_INCLUDE_BCD_SWAR 1
+#endif
+/*Feature: turn the per handle runtime policy on or off, to skip the compiled in checks for some handles or calls*/
+#define DS3231_INCLUDE_RUNTIME_POLICY 1
+/*Feature: turn the drift estimation and automatic aging offset tuning on or off, requires the aging offset calibration, the calendar and the time synchronization*/
+#define DS3231_INCLUDE_DRIFT_ESTIMATION 1
+/*Feature: turn the time synchronization against a reference clock (aligned set) on or off, requires the calendar*/
+#define DS3231_INCLUDE_TIME_SYNC 1
+/*Feature: turn the software timer service on the alarms on or off, requires the calendar and alarm 1 or alarm 2*/
+#define DS3231_INCLUDE_TIMER_SERVICE 1
+/*Feature: turn the self re-arming interval alarm on or off, requires the calendar and alarm 1*/
+#define DS3231_INCLUDE_INTERVAL_ALARM 1
+/*Feature: turn the cron expression alarm on or off, requires the calendar and alarm 2*/
+#define DS3231_INCLUDE_CRON_ALARM 1
+/*Feature: turn the wake up planner on or off, that coalesces deadlines with tolerance windows into few wake ups, requires the calendar, alarm 1 and alarm 2*/
+#define DS3231_INCLUDE_WAKE_PLANNER 1
+/*Feature: turn the declarative device config on or off, that writes only the registers that differ from the desired state*/
+#define DS3231_INCLUDE_DEVICE_CONFIG 1
+/*Feature: turn the adaptive temperature monitor with threshold and rate of change events on or off, requires the temperature*/
+#define DS3231_INCLUDE_TEMPERATURE_MONITOR 1
+/*Feature: turn the delta encoded time and temperature sample store on or off*/
+#define DS3231_INCLUDE_SAMPLE_STORE 1
 
 
 /*************************************************************************************/
@@ -74,6 +100,39 @@ extern "C" {
 
 static const uint16_t DS3231_STARTUP_DELAY_IN_MS = 2000;
 
+#if DS3231_INCLUDE_DRIFT_ESTIMATION
+/*Number of seconds edges kept in the drift history*/
+#define DS3231_DRIFT_HISTORY_LENGTH 16
+/*Minimum number of samples before the drift is estimated*/
+static const uint8_t DS3231_DRIFT_MIN_SAMPLES = 4;
+/*Minimum time between two samples of a pair, shorter pairs are too noisy to be used*/
+static const uint32_t DS3231_DRIFT_MIN_PAIR_INTERVAL_S = 3600;
+/*The aging offset is only changed for a drift beyond this, in parts per billion*/
+static const int32_t DS3231_DRIFT_HYSTERESIS_PPB = 150;
+/*Uncertainty of the seconds edge of a sample, 0.1 ms is about 30 ppb over DS3231_DRIFT_MIN_PAIR_INTERVAL_S*/
+static const int64_t DS3231_DRIFT_EDGE_UNCERTAINTY_NS = 100000;
+#endif
+
+#if DS3231_INCLUDE_TIMER_SERVICE
+/*Maximum number of software timers started at the same time on one timer service*/
+#define DS3231_TIMER_SERVICE_CAPACITY 32
+#endif
+
+#if DS3231_INCLUDE_WAKE_PLANNER
+/*Maximum number of tasks of one wake planner, at most 32 as the tasks served by a wake up are returned as a bit mask*/
+#define DS3231_WAKE_PLANNER_CAPACITY 16
+#endif
+
+#if DS3231_INCLUDE_TEMPERATURE_MONITOR
+/*Shortest interval between two samples of a changing temperature, each of them is a forced conversion of up to 200 ms*/
+static const uint32_t DS3231_TEMPERATURE_MONITOR_MIN_INTERVAL_S = 2;
+#endif
+
+#if DS3231_INCLUDE_SAMPLE_STORE
+/*Bytes of the ring buffer of one sample store, from 32 up to 65535. A sample taken at a steady interval takes 2 bytes*/
+#define DS3231_SAMPLE_STORE_SIZE 512
+#endif
+
 #ifdef __cplusplus
 }
 #endif
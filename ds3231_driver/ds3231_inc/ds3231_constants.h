@@ -103,6 +103,47 @@ static const ds3231_mask_and_range_t DS3231_MASK_AND_RANGE_LUT[7] = {
 #endif
 
 
+#if DS3231_INCLUDE_SAFE_RANGE_CHECK
+/*Days in each month of a non-leap year, indexed by month. Invalid months are given 31 to only fail the month check*/
+static const uint8_t DS3231_DAYS_IN_MONTH_LUT[16] = {
+	31, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 31, 31, 31
+};
+#endif
+
+
+#if DS3231_INCLUDE_BCD_SWAR
+/*Register masks of the time block packed into one 64 bit word, seconds in the least significant byte*/
+static const uint64_t DS3231_TIME_BLOCK_MASK =
+	((uint64_t)DS3231_MASK_SECOND) |
+	((uint64_t)DS3231_MASK_MINUTE << 8) |
+	((uint64_t)DS3231_MASK_HOUR << 16) |
+	((uint64_t)DS3231_MASK_DAY << 24) |
+	((uint64_t)DS3231_MASK_DATE << 32) |
+	((uint64_t)DS3231_MASK_MONTH << 40) |
+	((uint64_t)DS3231_MASK_YEAR << 48);
+#else
+/*BCD tens digit to binary, used by the byte lookup BCD conversion*/
+static const uint8_t DS3231_BCD_TENS_LUT[16] = {
+	0, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120, 130, 140, 150
+};
+
+
+/*Binary 0 to 99 to BCD, used by the byte lookup BCD conversion*/
+static const uint8_t DS3231_HEX_TO_BCD_LUT[100] = {
+	0X00, 0X01, 0X02, 0X03, 0X04, 0X05, 0X06, 0X07, 0X08, 0X09,
+	0X10, 0X11, 0X12, 0X13, 0X14, 0X15, 0X16, 0X17, 0X18, 0X19,
+	0X20, 0X21, 0X22, 0X23, 0X24, 0X25, 0X26, 0X27, 0X28, 0X29,
+	0X30, 0X31, 0X32, 0X33, 0X34, 0X35, 0X36, 0X37, 0X38, 0X39,
+	0X40, 0X41, 0X42, 0X43, 0X44, 0X45, 0X46, 0X47, 0X48, 0X49,
+	0X50, 0X51, 0X52, 0X53, 0X54, 0X55, 0X56, 0X57, 0X58, 0X59,
+	0X60, 0X61, 0X62, 0X63, 0X64, 0X65, 0X66, 0X67, 0X68, 0X69,
+	0X70, 0X71, 0X72, 0X73, 0X74, 0X75, 0X76, 0X77, 0X78, 0X79,
+	0X80, 0X81, 0X82, 0X83, 0X84, 0X85, 0X86, 0X87, 0X88, 0X89,
+	0X90, 0X91, 0X92, 0X93, 0X94, 0X95, 0X96, 0X97, 0X98, 0X99
+};
+#endif
+
+
 /*An array of default register values used in reset*/
 static const uint8_t REGISTER_DEFAULT_VALUE[] = {
 	0X00,
@@ -151,12 +192,158 @@ static const uint8_t DS3231_ALARM_2_MASK_BITS[5][4] = {
 	/*OSC Stop Flag = TRUE*/
 	static const int DS3231_OSCILLATOR_STOPPED = 1;
 	static const int DS3231_NUMBER_OF_TIME_REGISTERS = 7;
+	static const int DS3231_NUMBER_OF_ALARM_1_REGISTERS = 4;
+	static const int DS3231_NUMBER_OF_ALARM_2_REGISTERS = 3;
+	/*The status block is read from the control register up to the temperature LSB*/
+	static const uint8_t DS3231_STATUS_BLOCK_LENGTH = DS3231_REGISTER_TEMP_LSB - DS3231_REGISTER_CONTROL + 1;
 
 #if DS3231_INCLUDE_TEMPERATURE
 	static const uint32_t DS3231_TEMPERATURE_READ_DELAY = 5;
 	static const uint32_t DS3231_TEMPERATURE_READ_TIMEOUT = 250;
 #endif
 
+#if DS3231_INCLUDE_CALENDAR
+	/*Constants used in civil calendar and epoch conversions*/
+	static const int32_t DS3231_SECONDS_PER_MINUTE = 60;
+	static const int32_t DS3231_SECONDS_PER_HOUR = 3600;
+	static const int32_t DS3231_SECONDS_PER_DAY = 86400;
+	static const int32_t DS3231_DAYS_PER_WEEK = 7;
+	static const int32_t DS3231_DAYS_PER_ERA = 146097;
+	static const int32_t DS3231_DAYS_FROM_ERA_START_TO_EPOCH = 719468;
+	/*1970-01-01 was a thursday*/
+	static const int32_t DS3231_EPOCH_DAY_OF_WEEK = DS3231_DAY_THURSDAY;
+#endif
+
+#if DS3231_INCLUDE_DRIFT_ESTIMATION
+	/*Aging offset sensitivity at 25 degrees, one LSB is about 0.1 ppm*/
+	static const int32_t DS3231_AGING_OFFSET_PPB_PER_LSB = 100;
+#endif
+
+#if DS3231_INCLUDE_DRIFT_ESTIMATION | DS3231_INCLUDE_TIME_SYNC
+	static const int64_t DS3231_NS_PER_SECOND = 1000000000LL;
+#endif
+
+#if DS3231_INCLUDE_TIME_SYNC
+	/*Number of reads used to measure the bus latency*/
+	static const uint8_t DS3231_SYNC_LATENCY_PROBES = 4;
+	/*The last part of a wait is spent polling the reference clock instead of in the delay function, to absorb its wake up latency*/
+	static const int64_t DS3231_SYNC_SPIN_NS = 5000000LL;
+	/*The coarse search of a seconds edge polls every this many milliseconds, the edge is then known within about this*/
+	static const uint32_t DS3231_SYNC_COARSE_STEP_MS = 50;
+	/*Each pass of the fine search splits the bound of the edge in this many parts, with up to one probe less, all in the same second*/
+	static const uint8_t DS3231_SYNC_PARTS_PER_PASS = 8;
+	/*The fine search gives up refining after this many passes, one per second*/
+	static const uint8_t DS3231_SYNC_MAX_PASSES = 6;
+	/*Waiting for a seconds edge gives up after this*/
+	static const int64_t DS3231_SYNC_EDGE_TIMEOUT_NS = 1500000000LL;
+#endif
+
+#if (DS3231_INCLUDE_ALARM_1 & DS3231_INCLUDE_CALENDAR) | DS3231_INCLUDE_INTERVAL_ALARM | DS3231_INCLUDE_CRON_ALARM | DS3231_INCLUDE_WAKE_PLANNER
+	/*The epoch and re-arming alarms read from the seconds register up to the status register*/
+	static const uint8_t DS3231_NUMBER_OF_REGISTERS_TO_STATUS = DS3231_REGISTER_CONTROL_STATUS - DS3231_REGISTER_SECONDS + 1;
+#endif
+
+#if (DS3231_INCLUDE_ALARM_1 & DS3231_INCLUDE_CALENDAR) | DS3231_INCLUDE_INTERVAL_ALARM | DS3231_INCLUDE_WAKE_PLANNER
+	/*The epoch and re-arming alarms write from the alarm 1 registers up to the status register*/
+	static const uint8_t DS3231_ALARM_1_WRITE_LENGTH = DS3231_REGISTER_CONTROL_STATUS - DS3231_REGISTER_ALARM1_SECONDS + 1;
+#endif
+
+#if DS3231_INCLUDE_ALARM_1 & DS3231_INCLUDE_CALENDAR
+	/*The epoch alarms read back and write the control and status registers only*/
+	static const uint8_t DS3231_CONTROL_AND_STATUS_LENGTH = DS3231_REGISTER_CONTROL_STATUS - DS3231_REGISTER_CONTROL + 1;
+#endif
+
+#if DS3231_INCLUDE_CRON_ALARM
+	/*The cron alarm writes from the alarm 2 registers up to the status register*/
+	static const uint8_t DS3231_CRON_ALARM_WRITE_LENGTH = DS3231_REGISTER_CONTROL_STATUS - DS3231_REGISTER_ALARM2_MINUTES + 1;
+	/*Range and names of the cron fields: minute, hour, date, month and day of week, where both 0 and 7 are sunday*/
+	static const ds3231_cron_field_t DS3231_CRON_FIELDS[DS3231_CRON_NUMBER_OF_FIELDS] = {
+		{0, 59, NULL},
+		{0, 23, NULL},
+		{1, 31, NULL},
+		{1, 12, "JANFEBMARAPRMAYJUNJULAUGSEPOCTNOVDEC"},
+		{0, 7, "SUNMONTUEWEDTHUFRISAT"},
+	};
+	/*The longest month of each month, indexed by month, to find the dates that never come*/
+	static const uint8_t DS3231_CRON_LONGEST_MONTH[13] = {0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	/*The next match is searched from this many seconds ahead, so the alarm can't be missed while it is written*/
+	static const int64_t DS3231_CRON_MIN_LEAD_S = 2;
+	/*The next match is searched this many days ahead at most, enough for the 29th of february*/
+	static const int32_t DS3231_CRON_SEARCH_DAYS = 8 * 366;
+	/*A date of alarm 2 comes back within this many days, two months as the 31st skips the months without it*/
+	static const int32_t DS3231_CRON_DATE_RECURRENCE_DAYS = 62;
+#endif
+
+#if DS3231_INCLUDE_TIMER_SERVICE
+	/*Heap index of a timer that is not started*/
+	static const uint16_t DS3231_TIMER_NOT_QUEUED = 0xFFFF;
+	/*Programmed deadline of a timer service with nothing in the hardware alarm*/
+	static const int64_t DS3231_TIMER_NOT_PROGRAMMED = INT64_MIN;
+	/*A deadline is programmed at least this many seconds ahead, so the alarm can't be missed while it is written*/
+	static const int64_t DS3231_TIMER_MIN_LEAD_S = 2;
+#endif
+
+#if DS3231_INCLUDE_WAKE_PLANNER
+	/*Deadline of a one shot task that is done, and wake up of alarm 1 when it is off*/
+	static const int64_t DS3231_WAKE_NEVER = INT64_MAX;
+	/*A wake up is programmed at least this many seconds ahead, so the alarm can't be missed while it is written*/
+	static const int64_t DS3231_WAKE_MIN_LEAD_S = 2;
+	/*Alarm 1 matches the date, it reaches this far ahead in every month*/
+	static const int64_t DS3231_WAKE_MAX_SLEEP_S = 28 * 86400LL;
+	/*I2C bytes around the data of a read, the address, the register and the repeated address*/
+	static const uint8_t DS3231_I2C_READ_OVERHEAD_BYTES = 3;
+#endif
+
+#if DS3231_INCLUDE_WAKE_PLANNER | DS3231_INCLUDE_DEVICE_CONFIG
+	/*I2C bytes around the data of a write, the address and the register*/
+	static const uint8_t DS3231_I2C_WRITE_OVERHEAD_BYTES = 2;
+#endif
+
+#if DS3231_INCLUDE_DEVICE_CONFIG
+	/*The device config covers the registers from alarm 1 seconds up to the aging offset*/
+	static const uint8_t DS3231_DEVICE_CONFIG_LENGTH = DS3231_REGISTER_AGING_OFFSET - DS3231_REGISTER_ALARM1_SECONDS + 1;
+	/*The part each of these registers belongs to*/
+	static const ds3231_config_part_mask_t DS3231_DEVICE_CONFIG_PARTS[DS3231_REGISTER_AGING_OFFSET - DS3231_REGISTER_ALARM1_SECONDS + 1] = {
+		DS3231_CONFIG_ALARM_1, DS3231_CONFIG_ALARM_1, DS3231_CONFIG_ALARM_1, DS3231_CONFIG_ALARM_1,
+		DS3231_CONFIG_ALARM_2, DS3231_CONFIG_ALARM_2, DS3231_CONFIG_ALARM_2,
+		DS3231_CONFIG_CONTROL, DS3231_CONFIG_STATUS, DS3231_CONFIG_AGING_OFFSET
+	};
+	/*The bits of these registers kept in a config blob, all but CONV, the busy bit and the flags*/
+	static const uint8_t DS3231_CONFIG_BLOB_MASK[DS3231_REGISTER_AGING_OFFSET - DS3231_REGISTER_ALARM1_SECONDS + 1] = {
+		0XFF, 0XFF, 0XFF, 0XFF, 0XFF, 0XFF, 0XFF, 0XDF, 0X08, 0XFF
+	};
+	/*CRC-16/CCITT-FALSE of a config blob*/
+	static const uint16_t DS3231_CONFIG_BLOB_CRC_POLYNOMIAL = 0X1021;
+	static const uint16_t DS3231_CONFIG_BLOB_CRC_INITIAL = 0XFFFF;
+#endif
+
+#if DS3231_INCLUDE_TEMPERATURE_MONITOR
+	/*DS3231 converts the temperature by itself every 64 seconds, a stable temperature is read at this interval without a forced conversion*/
+	static const uint32_t DS3231_TEMPERATURE_MONITOR_MAX_INTERVAL_S = 64;
+	/*Quarter degrees per minute from which the temperature counts as changing, when the monitor has no rate limit*/
+	static const int32_t DS3231_TEMPERATURE_MONITOR_CHANGING_RATE = 2;
+	/*The rate is measured over a change of at least this many quarter degrees, or over the longest interval, as one quarter is the noise of the sensor*/
+	static const int16_t DS3231_TEMPERATURE_MONITOR_MIN_STEP = 2;
+	/*The rate is in quarter degrees per this many seconds*/
+	static const int32_t DS3231_TEMPERATURE_MONITOR_RATE_PERIOD_S = 60;
+	/*Default hysteresis of the thresholds, one degree*/
+	static const int16_t DS3231_TEMPERATURE_MONITOR_HYSTERESIS = 4;
+	/*Time of the last sample of a monitor that has not sampled yet*/
+	static const int64_t DS3231_TEMPERATURE_NOT_SAMPLED = INT64_MIN;
+#endif
+
+#if DS3231_INCLUDE_SAMPLE_STORE
+	/*A record is the time delta of delta, a zig-zag varint of up to 10 bytes, then the temperature delta, a zig-zag varint of up to 3 bytes*/
+	static const uint8_t DS3231_SAMPLE_RECORD_MAX_LENGTH = 13;
+	/*Varint bytes carry 7 bits each, the most significant bit is set on every byte but the last*/
+	static const uint8_t DS3231_VARINT_CONTINUE = 0X80;
+#endif
+
+#if DS3231_INCLUDE_SAMPLE_STORE & DS3231_INCLUDE_CALENDAR
+	/*A capture reads from the seconds register up to the temperature LSB*/
+	static const uint8_t DS3231_SAMPLE_CAPTURE_LENGTH = DS3231_REGISTER_TEMP_LSB - DS3231_REGISTER_SECONDS + 1;
+#endif
+
 static const uint8_t DS3231_VERSION_MAJOR = 2;
 static const uint8_t DS3231_VERSION_MINOR = 0;
 
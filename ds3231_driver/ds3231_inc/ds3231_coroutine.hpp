@@ -0,0 +1,387 @@
+/**
+ * @file ds3231_coroutine.hpp
+ * @brief DS3231 Real Time Clock C Driver
+ * @author Reza G. Ebrahimi <https://github.com/ebrezadev>
+ * @version 2.0
+ * @license MIT
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Reza G. Ebrahimi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef __DS3231_COROUTINE_HPP__
+#define __DS3231_COROUTINE_HPP__
+
+#include "ds3231.hpp"
+
+#if defined(__cpp_impl_coroutine)
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ds3231
+{
+	/**
+	 * @brief The scheduler interface
+	 *
+	 * The coroutines suspend on a scheduler instead of calling the delay function of the handle. Any event loop or timer can be injected by implementing it.
+	 *
+	 */
+	class scheduler
+	{
+	public:
+		virtual ~scheduler() = default;
+
+		/**
+		 * @brief The schedule after function
+		 *
+		 * @param delay: the time to wait before resuming
+		 * @param handle: the suspended coroutine, to be resumed once on the thread driving the scheduler
+		 */
+		virtual void schedule_after(std::chrono::milliseconds delay, std::coroutine_handle<> handle) = 0;
+	};
+
+	/**
+	 * @brief A single threaded timer scheduler
+	 *
+	 * Keeps the suspended coroutines in a queue ordered by deadline. run() sleeps until the earliest deadline, resumes it and returns once the queue is empty.
+	 *
+	 */
+	class timer_scheduler : public scheduler
+	{
+	public:
+		void schedule_after(std::chrono::milliseconds delay, std::coroutine_handle<> handle) override
+		{
+			queue_.push(entry{std::chrono::steady_clock::now() + delay, sequence_++, handle});
+		}
+
+		/**
+		 * @brief The run function
+		 *
+		 * Drives all the scheduled coroutines on the calling thread.
+		 *
+		 */
+		void run()
+		{
+			while (!queue_.empty())
+			{
+				entry next = queue_.top();
+				queue_.pop();
+
+				std::this_thread::sleep_until(next.deadline);
+				next.handle.resume();
+			}
+		}
+
+	private:
+		struct entry
+		{
+			std::chrono::steady_clock::time_point deadline;
+			uint64_t sequence;
+			std::coroutine_handle<> handle;
+
+			/*Earliest deadline first, ties in scheduling order*/
+			bool operator<(const entry &other) const
+			{
+				return (deadline != other.deadline) ? (deadline > other.deadline) : (sequence > other.sequence);
+			}
+		};
+
+		std::priority_queue<entry, std::vector<entry>> queue_;
+		uint64_t sequence_ = 0;
+	};
+
+	/**
+	 * @brief The result of a coroutine, a value along with the error code of the C API.
+	 *
+	 */
+	template <class T>
+	struct result
+	{
+		ds3231_error_code_t error;
+		T value;
+	};
+
+	/**
+	 * @brief A lazy coroutine task
+	 *
+	 * It starts when it is awaited, or when start() is called on a top level task. The awaiting coroutine is resumed when it finishes.
+	 *
+	 */
+	template <class T>
+	class task
+	{
+	public:
+		struct promise_type
+		{
+			T value{};
+			std::coroutine_handle<> continuation;
+
+			task get_return_object() { return task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+			std::suspend_always initial_suspend() noexcept { return {}; }
+
+			struct final_awaiter
+			{
+				bool await_ready() noexcept { return false; }
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+				{
+					std::coroutine_handle<> continuation = handle.promise().continuation;
+					return continuation ? continuation : std::noop_coroutine();
+				}
+				void await_resume() noexcept {}
+			};
+
+			final_awaiter final_suspend() noexcept { return {}; }
+			void return_value(T return_value) { value = std::move(return_value); }
+			void unhandled_exception() { std::terminate(); }
+		};
+
+		explicit task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+		task(task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+		task(const task &) = delete;
+		task &operator=(const task &) = delete;
+		~task()
+		{
+			if (handle_)
+			{
+				handle_.destroy();
+			}
+		}
+
+		bool await_ready() const noexcept { return handle_.done(); }
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+		{
+			handle_.promise().continuation = continuation;
+			return handle_;
+		}
+		T await_resume() { return std::move(handle_.promise().value); }
+
+		/**
+		 * @brief Starts a top level task. It runs until its first suspension.
+		 *
+		 */
+		void start() { handle_.resume(); }
+
+		/**
+		 * @brief Returns true once the task has finished.
+		 *
+		 */
+		bool done() const { return handle_.done(); }
+
+		/**
+		 * @brief Returns the value of a finished task.
+		 *
+		 */
+		const T &get() const { return handle_.promise().value; }
+
+	private:
+		std::coroutine_handle<promise_type> handle_;
+	};
+
+	/**
+	 * @brief An awaitable that suspends the coroutine on the scheduler for a delay.
+	 *
+	 */
+	struct sleep_for
+	{
+		scheduler &sched;
+		std::chrono::milliseconds delay;
+
+		bool await_ready() const noexcept { return delay.count() <= 0; }
+		void await_suspend(std::coroutine_handle<> handle) { sched.schedule_after(delay, handle); }
+		void await_resume() const noexcept {}
+	};
+
+	/**
+	 * @brief The oscillator check coroutine
+	 *
+	 * The same as ds3231_is_running, with the two DS3231_OSC_FLAG_DELAY_MS waits suspended on the scheduler.
+	 *
+	 * @param handle: pointer to a handle of DS3231, which should outlive the task
+	 * @param sched: the scheduler to suspend on
+	 * @return Returns DS3231_TRUE in value if the oscillator is running
+	 */
+	inline task<result<ds3231_bool_t>> async_is_running(const ds3231_handle_t *handle, scheduler &sched)
+	{
+		ds3231_bool_t OSF_bit;
+
+		ds3231_error_code_t error = _ds3231_bit_get(handle, DS3231_REGISTER_CONTROL_STATUS, DS3231_BIT_OSF, &OSF_bit);
+		if ((error != DS3231_ERROR_OK) || (OSF_bit != (ds3231_bool_t)DS3231_OSCILLATOR_STOPPED))
+		{
+			co_return result<ds3231_bool_t>{error, DS3231_TRUE};
+		}
+
+		co_await sleep_for{sched, std::chrono::milliseconds(DS3231_OSC_FLAG_DELAY_MS)};
+
+		/*Manually reset the OSF bit*/
+		error = _ds3231_bit_set(handle, DS3231_REGISTER_CONTROL_STATUS, DS3231_BIT_OSF, DS3231_FALSE);
+		if (error != DS3231_ERROR_OK)
+		{
+			co_return result<ds3231_bool_t>{error, DS3231_FALSE};
+		}
+
+		co_await sleep_for{sched, std::chrono::milliseconds(DS3231_OSC_FLAG_DELAY_MS)};
+
+		error = _ds3231_bit_get(handle, DS3231_REGISTER_CONTROL_STATUS, DS3231_BIT_OSF, &OSF_bit);
+
+		co_return result<ds3231_bool_t>{error, (OSF_bit != (ds3231_bool_t)DS3231_OSCILLATOR_STOPPED) ? DS3231_TRUE : DS3231_FALSE};
+	}
+
+#if DS3231_INCLUDE_TEMPERATURE
+	/**
+	 * @brief The temperature conversion coroutine
+	 *
+	 * Waits for the BSY bit, forces a conversion and waits for the CONV bit to clear, suspending on the scheduler between polls.
+	 *
+	 * @param handle: pointer to a handle of DS3231, which should outlive the task
+	 * @param sched: the scheduler to suspend on
+	 * @return Returns the temperature in value, in degrees centigrade multiplied by 100
+	 */
+	inline task<result<int16_t>> async_get_temperature(const ds3231_handle_t *handle, scheduler &sched)
+	{
+		ds3231_error_code_t error;
+		ds3231_bool_t bit = DS3231_TRUE;
+		uint32_t timeout = DS3231_TEMPERATURE_READ_TIMEOUT;
+
+		/*Wait for the BSY bit*/
+		for (;;)
+		{
+			error = _ds3231_bit_get(handle, DS3231_REGISTER_CONTROL_STATUS, DS3231_BIT_BSY, &bit);
+			if ((error != DS3231_ERROR_OK) || (bit == DS3231_FALSE))
+			{
+				break;
+			}
+
+			if (timeout <= DS3231_TEMPERATURE_READ_DELAY)
+			{
+				co_return result<int16_t>{DS3231_ERROR_TEMPERATURE_BUSY_TIMEOUT, 0};
+			}
+			timeout -= DS3231_TEMPERATURE_READ_DELAY;
+
+			co_await sleep_for{sched, std::chrono::milliseconds(DS3231_TEMPERATURE_READ_DELAY)};
+		}
+		if (error != DS3231_ERROR_OK)
+		{
+			co_return result<int16_t>{error, 0};
+		}
+
+		/*Set the CONV bit to start conversion of temperature to digital*/
+		error = _ds3231_bit_set(handle, DS3231_REGISTER_CONTROL, DS3231_BIT_CONV, DS3231_TRUE);
+		if (error != DS3231_ERROR_OK)
+		{
+			co_return result<int16_t>{error, 0};
+		}
+
+		/*Wait for the CONV bit to clear*/
+		timeout = DS3231_TEMPERATURE_READ_TIMEOUT;
+
+		for (;;)
+		{
+			co_await sleep_for{sched, std::chrono::milliseconds(DS3231_TEMPERATURE_READ_DELAY)};
+
+			error = _ds3231_bit_get(handle, DS3231_REGISTER_CONTROL, DS3231_BIT_CONV, &bit);
+			if ((error != DS3231_ERROR_OK) || (bit == DS3231_FALSE))
+			{
+				break;
+			}
+
+			if (timeout <= DS3231_TEMPERATURE_READ_DELAY)
+			{
+				co_return result<int16_t>{DS3231_ERROR_TEMPERATURE_CONVERSION_TIMEOUT, 0};
+			}
+			timeout -= DS3231_TEMPERATURE_READ_DELAY;
+		}
+		if (error != DS3231_ERROR_OK)
+		{
+			co_return result<int16_t>{error, 0};
+		}
+
+		/*Read the MSB and LSB bytes. data[0] is MSB, data[1] is LSB*/
+		uint8_t data[2];
+
+#if DS3231_INCLUDE_EXCLUSION_HOOK
+		if (handle->interface.interface_exclusion.interface_lock((void *)handle->interface.interface_exclusion.mutex_handle) != 0)
+		{
+			co_return result<int16_t>{DS3231_ERROR_INTERFACE_MUTEX_LOCK, 0};
+		}
+#endif
+		int read_result = handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_TEMP_MSB, data, 2);
+#if DS3231_INCLUDE_EXCLUSION_HOOK
+		if (handle->interface.interface_exclusion.interface_unlock((void *)handle->interface.interface_exclusion.mutex_handle) != 0)
+		{
+			co_return result<int16_t>{DS3231_ERROR_INTERFACE_MUTEX_UNLOCK, 0};
+		}
+#endif
+		if (read_result != 0)
+		{
+			co_return result<int16_t>{DS3231_ERROR_INTERFACE_READ, 0};
+		}
+
+		co_return result<int16_t>{DS3231_ERROR_OK, ds3231_temperature_raw_to_centi(_ds3231_temperature_raw(data))};
+	}
+#endif
+
+#if DS3231_INCLUDE_ALARM_1 || DS3231_INCLUDE_ALARM_2
+	/**
+	 * @brief The alarm wait coroutine
+	 *
+	 * Polls the alarm flag, suspending on the scheduler between polls, and clears it once it is set.
+	 *
+	 * @param handle: pointer to a handle of DS3231, which should outlive the task
+	 * @param sched: the scheduler to suspend on
+	 * @param flag: DS3231_BIT_A1F for alarm 1 or DS3231_BIT_A2F for alarm 2
+	 * @param poll_interval: the time between two polls
+	 * @return Returns 0 for no error
+	 */
+	inline task<ds3231_error_code_t> async_alarm_wait(const ds3231_handle_t *handle, scheduler &sched, ds3231_register_bit_t flag, std::chrono::milliseconds poll_interval = std::chrono::milliseconds(100))
+	{
+		ds3231_bool_t flag_bit = DS3231_FALSE;
+
+		for (;;)
+		{
+			ds3231_error_code_t error = _ds3231_bit_get(handle, DS3231_REGISTER_CONTROL_STATUS, flag, &flag_bit);
+			if (error != DS3231_ERROR_OK)
+			{
+				co_return error;
+			}
+
+			if (flag_bit == DS3231_TRUE)
+			{
+				break;
+			}
+
+			co_await sleep_for{sched, poll_interval};
+		}
+
+		co_return _ds3231_bit_set(handle, DS3231_REGISTER_CONTROL_STATUS, flag, DS3231_FALSE);
+	}
+#endif
+}
+
+#endif
+
+#endif
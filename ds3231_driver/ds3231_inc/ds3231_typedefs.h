@@ -203,6 +203,29 @@ extern "C"
 	} ds3231_int_sqw_pin_t;
 
 
+	/**
+	 * @brief Status block data type, the control, status, aging offset and temperature registers decoded.
+	 *
+	 */
+	typedef struct
+	{
+		ds3231_bool_t battery_backed_oscillator;		/*EOSC, as in ds3231_battery_backed_oscillator_control*/
+		ds3231_bool_t battery_backed_sqw;				/*BBSQW*/
+		ds3231_bool_t converting;						/*CONV, a temperature conversion started by the application is running*/
+		ds3231_sqw_output_wave_frequency_t sqw_frequency;
+		ds3231_int_sqw_pin_t int_sqw_pin;
+		ds3231_bool_t alarm_1_interrupt;				/*A1IE*/
+		ds3231_bool_t alarm_2_interrupt;				/*A2IE*/
+		ds3231_bool_t oscillator_stopped;				/*OSF, the time is not valid since the oscillator stopped*/
+		ds3231_bool_t wave_32khz;						/*EN32kHz*/
+		ds3231_bool_t busy;								/*BSY, a temperature conversion is running*/
+		ds3231_bool_t alarm_1_flag;						/*A1F*/
+		ds3231_bool_t alarm_2_flag;						/*A2F*/
+		int8_t aging_offset;
+		int16_t temperature;							/*In quarter degrees as ds3231_get_temperature_raw, e.g. 103 is 25.75 and -1 is -0.25*/
+	} ds3231_status_block_t;
+
+
 	/**
 	 * @brief Seconds data type. Range: 0 - 59.
 	 *
@@ -254,6 +277,189 @@ extern "C"
 	} ds3231_time_and_calendar_t;
 
 
+	/**
+	 * @brief Epoch data type. Seconds since 1970-01-01 00:00:00. Range: 1900-01-01 00:00:00 to 2099-12-31 23:59:59.
+	 *
+	 */
+	typedef int64_t ds3231_epoch_t;
+
+
+#if DS3231_INCLUDE_SAFE_RANGE_CHECK
+	/**
+	 * @brief Time and calendar field bits, one bit per register of ds3231_time_register_t.
+	 *
+	 */
+	typedef enum
+	{
+		DS3231_FIELD_SECOND = 1 << DS3231_SECONDS,
+		DS3231_FIELD_MINUTE = 1 << DS3231_MINUTES,
+		DS3231_FIELD_HOUR = 1 << DS3231_HOURS,
+		DS3231_FIELD_DAY = 1 << DS3231_DAY,
+		DS3231_FIELD_DATE = 1 << DS3231_DATE,
+		DS3231_FIELD_MONTH = 1 << DS3231_MONTH,
+		DS3231_FIELD_YEAR = 1 << DS3231_YEAR
+	} ds3231_field_t;
+
+
+	/**
+	 * @brief A mask of ds3231_field_t bits. 0 means no field.
+	 *
+	 */
+	typedef uint8_t ds3231_field_mask_t;
+#endif
+
+
+#if DS3231_INCLUDE_RUNTIME_POLICY
+	/**
+	 * @brief Runtime policy bits. Each bit skips one of the compiled in checks for a handle.
+	 *
+	 */
+	typedef enum
+	{
+		DS3231_POLICY_SKIP_RANGE_CHECK = 1 << 0,
+		DS3231_POLICY_SKIP_WRITE_VERIFICATION = 1 << 1,
+		DS3231_POLICY_SKIP_CONNECTION_CHECK = 1 << 2
+	} ds3231_policy_bit_t;
+
+
+	/**
+	 * @brief A mask of ds3231_policy_bit_t bits.
+	 *
+	 */
+	typedef uint8_t ds3231_policy_t;
+
+
+/*All the compiled in checks run, the default of a zeroed handle*/
+#define DS3231_POLICY_SAFE ((ds3231_policy_t)0)
+/*All the compiled in checks are skipped, except the NULL check*/
+#define DS3231_POLICY_LEAN ((ds3231_policy_t)(DS3231_POLICY_SKIP_RANGE_CHECK | DS3231_POLICY_SKIP_WRITE_VERIFICATION | DS3231_POLICY_SKIP_CONNECTION_CHECK))
+#endif
+
+
+#if DS3231_INCLUDE_DRIFT_ESTIMATION | DS3231_INCLUDE_TIME_SYNC | DS3231_INCLUDE_INTERVAL_ALARM
+	/**
+	 * @brief The reference clock hook
+	 *
+	 * Returns the reference time in nanoseconds since 1970-01-01, e.g. CLOCK_REALTIME under NTP.
+	 *
+	 */
+	typedef int64_t (*ds3231_reference_clock_fp)(void);
+#endif
+
+
+#if DS3231_INCLUDE_TIME_SYNC
+	/**
+	 * @brief The result of a phase measurement, the seconds edge of DS3231 against the reference clock.
+	 *
+	 */
+	typedef struct
+	{
+		ds3231_epoch_t rtc_epoch;	 /*The second of DS3231 that started at the edge*/
+		int64_t edge_ns;			 /*The reference time of the edge*/
+		int64_t offset_ns;			 /*DS3231 minus the reference, in nanoseconds*/
+		int64_t uncertainty_ns;		 /*The edge is within edge_ns plus or minus this*/
+		uint16_t transactions;		 /*I2C transactions used*/
+	} ds3231_phase_t;
+#endif
+
+
+#if DS3231_INCLUDE_DRIFT_ESTIMATION
+	/**
+	 * @brief A seconds edge of DS3231 and the reference time it happened at.
+	 *
+	 */
+	typedef struct
+	{
+		ds3231_epoch_t rtc_epoch;
+		int64_t reference_ns;
+	} ds3231_drift_sample_t;
+
+
+	/**
+	 * @brief Drift estimation state. Plain data, can be persisted and restored as is.
+	 *
+	 */
+	typedef struct
+	{
+		ds3231_drift_sample_t samples[DS3231_DRIFT_HISTORY_LENGTH];
+		uint8_t sample_count;
+		uint8_t next_sample;
+		int8_t aging_offset;
+		int32_t drift_ppb;
+	} ds3231_drift_t;
+#endif
+
+
+#if DS3231_INCLUDE_TIMER_SERVICE
+	/**
+	 * @brief The software timer callback, called from ds3231_timer_service_dispatch with the context given to ds3231_timer_init.
+	 *
+	 */
+	typedef void (*ds3231_timer_callback_fp)(void *context);
+
+
+	/**
+	 * @brief The hardware alarm behind a timer service.
+	 *
+	 */
+	typedef enum
+	{
+#if DS3231_INCLUDE_ALARM_1
+		DS3231_TIMER_ALARM_1, /*Second resolution*/
+#endif
+#if DS3231_INCLUDE_ALARM_2
+		DS3231_TIMER_ALARM_2, /*Minute resolution, the timers fire at the first full minute after their deadline*/
+#endif
+	} ds3231_timer_alarm_t;
+
+
+	/**
+	 * @brief Software timer data type. Owned by the application, the timer service only keeps a pointer to it while it is started.
+	 *
+	 */
+	typedef struct
+	{
+		ds3231_epoch_t deadline;		   /*Seconds since 1970-01-01 00:00:00 of the next fire*/
+		uint32_t period;				   /*Seconds between fires of a periodic timer, 0 for a one shot timer*/
+		ds3231_timer_callback_fp callback;
+		void *context;
+		uint16_t heap_index;			   /*Position in the heap of the timer service, DS3231_TIMER_NOT_QUEUED when not started*/
+	} ds3231_timer_t;
+
+
+	/**
+	 * @brief Timer service data type. A binary min-heap of the started timers ordered by deadline, the earliest one is in the hardware alarm.
+	 *
+	 */
+	typedef struct
+	{
+		ds3231_timer_t *heap[DS3231_TIMER_SERVICE_CAPACITY];
+		uint16_t count;
+		ds3231_timer_alarm_t alarm;
+		ds3231_epoch_t programmed;		   /*Deadline in the hardware alarm, DS3231_TIMER_NOT_PROGRAMMED if none*/
+		ds3231_bool_t dispatching;
+	} ds3231_timer_service_t;
+#endif
+
+
+#if DS3231_INCLUDE_INTERVAL_ALARM
+	/**
+	 * @brief Interval alarm data type. Alarm 1 fires every interval and is re-armed for the next one on each fire.
+	 *
+	 */
+	typedef struct
+	{
+		uint32_t interval;							/*Seconds between fires*/
+		uint32_t phase;								/*Seconds into the interval counted from 1970-01-01 00:00:00, e.g. 0 for every quarter past with 900*/
+		ds3231_epoch_t next_fire;					/*The fire alarm 1 is armed for*/
+		ds3231_reference_clock_fp reference_clock;	/*Optional, times the re-arm transactions. NULL to not measure*/
+		int64_t rearm_ns;							/*Reference time from before the read to after the write of the last re-arm*/
+		uint32_t late_s;							/*Seconds between the last fire and its re-arm, in the time of DS3231*/
+		uint32_t missed;							/*Fires missed because a re-arm came after the following fire*/
+	} ds3231_interval_alarm_t;
+#endif
+
+
 #if DS3231_INCLUDE_SAFE_RANGE_CHECK
 	/**
 	 * @brief Mask and range data type. Consists of register mask, min range, max range and range error.
@@ -357,6 +563,254 @@ extern "C"
 #endif
 
 
+#if DS3231_INCLUDE_CRON_ALARM
+	/**
+	 * @brief Cron field index data type, in the order of a cron expression.
+	 *
+	 */
+	typedef enum
+	{
+		DS3231_CRON_MINUTE = 0,
+		DS3231_CRON_HOUR,
+		DS3231_CRON_DATE,
+		DS3231_CRON_MONTH,
+		DS3231_CRON_DAY,
+		DS3231_CRON_NUMBER_OF_FIELDS
+	} ds3231_cron_field_index_t;
+
+
+	/**
+	 * @brief Cron field data type. The range of a field and its 3 letter names, the first one for the minimum, or NULL.
+	 *
+	 */
+	typedef struct
+	{
+		uint8_t minimum;
+		uint8_t maximum;
+		const char *names;
+	} ds3231_cron_field_t;
+
+
+	/**
+	 * @brief Compiled cron expression data type. One bit per matching value of each field, and the alarm 2 config programmed for it.
+	 *
+	 */
+	typedef struct
+	{
+		uint64_t minutes;				/*Bit n for minute n*/
+		uint32_t hours;					/*Bit n for hour n*/
+		uint32_t dates;					/*Bit n for date n, 1 to 31*/
+		uint16_t months;				/*Bit n for month n, 1 to 12*/
+		uint8_t days;					/*Bit n for day n, in ds3231_day_t numbering*/
+		ds3231_bool_t date_or_day;		/*Both the date and the day of week are restricted, either one matches like in vixie cron*/
+		ds3231_bool_t exact;			/*The alarm 2 rate only fires on matches, otherwise alarm 2 is re-armed for the next match on each fire*/
+		ds3231_alarm_2_config_t alarm;	/*The coarsest alarm 2 rate that fires on every match*/
+	} ds3231_cron_t;
+#endif
+
+
+#if DS3231_INCLUDE_WAKE_PLANNER
+/*The tasks served by a wake up are returned as a uint32_t bit mask*/
+#if DS3231_WAKE_PLANNER_CAPACITY > 32
+#error "DS3231_WAKE_PLANNER_CAPACITY must be at most 32"
+#endif
+
+	/**
+	 * @brief Wake up source data type, the alarm that fires for a planned wake up.
+	 *
+	 */
+	typedef enum
+	{
+		DS3231_WAKE_BY_ALARM_1, /*Programmed for the deadline that comes first*/
+		DS3231_WAKE_BY_ALARM_2	/*The periodic heartbeat, a forced wake up that serves the tasks in window*/
+	} ds3231_wake_source_t;
+
+
+	/**
+	 * @brief Wake planner task data type. A deadline with a tolerance window before it, one shot or periodic.
+	 *
+	 */
+	typedef struct
+	{
+		ds3231_epoch_t deadline;		/*Seconds since 1970-01-01 00:00:00 the task runs at the latest, DS3231_WAKE_NEVER when a one shot task is done*/
+		uint32_t tolerance;				/*Seconds before the deadline the task may run at the earliest*/
+		uint32_t period;				/*Seconds from a deadline to the next one, 0 for a one shot task*/
+	} ds3231_wake_task_t;
+
+
+	/**
+	 * @brief Wake planner data type. Alarm 1 wakes up at the first deadline and serves every task in window then, alarm 2 is an optional periodic heartbeat.
+	 *
+	 */
+	typedef struct
+	{
+		ds3231_wake_task_t tasks[DS3231_WAKE_PLANNER_CAPACITY];
+		uint8_t task_count;
+		ds3231_bool_t use_heartbeat;		/*Alarm 2 fires at the rate of heartbeat, for the wake ups the application has anyway*/
+		ds3231_alarm_2_config_t heartbeat;
+		ds3231_epoch_t programmed;			/*The wake up alarm 1 is armed for, DS3231_WAKE_NEVER if it is off*/
+	} ds3231_wake_planner_t;
+
+
+	/**
+	 * @brief Wake planner estimate data type, the counts of a simulated run of the plan.
+	 *
+	 */
+	typedef struct
+	{
+		uint32_t wakes;
+		uint32_t alarm_1_wakes;
+		uint32_t alarm_2_wakes;
+		uint32_t task_runs;			/*Every task run once per window, they would be task_runs wake ups without coalescing*/
+		uint32_t bus_bytes;			/*I2C bytes of the service calls, addresses included, without verification*/
+	} ds3231_wake_estimate_t;
+#endif
+
+
+#if DS3231_INCLUDE_DEVICE_CONFIG
+	/**
+	 * @brief Device config data type, the desired state of the alarm, control, status and aging offset registers.
+	 *
+	 */
+	typedef struct
+	{
+		ds3231_bool_t wave_32khz;								/*EN32kHz, as in ds3231_32khz_wave_control*/
+		ds3231_int_sqw_pin_t int_sqw_pin;
+		ds3231_sqw_output_wave_frequency_t sqw_frequency;
+		ds3231_bool_t battery_backed_sqw;						/*BBSQW, as in ds3231_battery_backed_sqw_control*/
+		ds3231_bool_t battery_backed_oscillator;				/*EOSC, as in ds3231_battery_backed_oscillator_control*/
+#if DS3231_INCLUDE_AGING_OFFSET_CALIBRATION
+		int8_t aging_offset;
+#endif
+#if DS3231_INCLUDE_ALARM_1
+		ds3231_bool_t alarm_1_interrupt;
+		ds3231_alarm_1_config_t alarm_1;
+#endif
+#if DS3231_INCLUDE_ALARM_2
+		ds3231_bool_t alarm_2_interrupt;
+		ds3231_alarm_2_config_t alarm_2;
+#endif
+	} ds3231_device_config_t;
+
+
+	/**
+	 * @brief Device config parts, one bit per group of registers written by ds3231_apply_config.
+	 *
+	 */
+	typedef enum
+	{
+		DS3231_CONFIG_ALARM_1 = 1 << 0,
+		DS3231_CONFIG_ALARM_2 = 1 << 1,
+		DS3231_CONFIG_CONTROL = 1 << 2,
+		DS3231_CONFIG_STATUS = 1 << 3,
+		DS3231_CONFIG_AGING_OFFSET = 1 << 4
+	} ds3231_config_part_t;
+
+
+	/**
+	 * @brief A mask of ds3231_config_part_t bits. 0 means nothing changed.
+	 *
+	 */
+	typedef uint8_t ds3231_config_part_mask_t;
+
+
+	/**
+	 * @brief Config blob data type, the registers from alarm 1 seconds up to the aging offset without the flags, then their CRC-16, most significant byte first.
+	 *
+	 */
+	typedef struct
+	{
+		uint8_t data[12];
+	} ds3231_config_blob_t;
+#endif
+
+
+#if DS3231_INCLUDE_TEMPERATURE_MONITOR
+	/**
+	 * @brief Temperature monitor event data type.
+	 *
+	 */
+	typedef enum
+	{
+		DS3231_TEMPERATURE_EVENT_HIGH = 0,	/*At or above the high threshold, cleared at the threshold minus the hysteresis*/
+		DS3231_TEMPERATURE_EVENT_LOW,		/*At or below the low threshold, cleared at the threshold plus the hysteresis*/
+		DS3231_TEMPERATURE_EVENT_RATE		/*Changing at or faster than the rate limit, cleared below half of it*/
+	} ds3231_temperature_event_t;
+
+
+	/**
+	 * @brief The temperature monitor callback, called from ds3231_temperature_monitor_sample when an event is raised (active DS3231_TRUE) or cleared.
+	 *
+	 */
+	typedef void (*ds3231_temperature_event_fp)(void *context, const ds3231_temperature_event_t event, const ds3231_bool_t active, const int16_t temperature);
+
+
+	/**
+	 * @brief Temperature monitor data type. The thresholds are set by the application after ds3231_temperature_monitor_init, the rest is the state of the monitor.
+	 *
+	 */
+	typedef struct
+	{
+		int16_t high;							/*Quarter degrees, INT16_MAX for no high event*/
+		int16_t low;							/*Quarter degrees, INT16_MIN for no low event*/
+		int16_t hysteresis;						/*Quarter degrees back past a threshold to clear its event*/
+		int16_t rate_limit;						/*Quarter degrees per minute, 0 for no rate event*/
+		ds3231_temperature_event_fp callback;
+		void *context;
+		int16_t temperature;					/*The last sample in quarter degrees*/
+		int32_t rate;							/*The last measured rate in quarter degrees per minute*/
+		int16_t reference;						/*The sample the rate is measured from*/
+		ds3231_epoch_t reference_at;			/*Seconds of the reference sample, DS3231_TEMPERATURE_NOT_SAMPLED before the first one*/
+		uint32_t interval;						/*Seconds to the next sample, below DS3231_TEMPERATURE_MONITOR_MAX_INTERVAL_S the samples are forced conversions*/
+		uint8_t active;							/*Bit n set while event n is raised*/
+	} ds3231_temperature_monitor_t;
+#endif
+
+
+#if DS3231_INCLUDE_SAMPLE_STORE
+	/**
+	 * @brief Sample data type, a time and a temperature.
+	 *
+	 */
+	typedef struct
+	{
+		ds3231_epoch_t time;			/*Seconds, e.g. since 1970-01-01 00:00:00*/
+		int16_t temperature;			/*Quarter degrees as ds3231_get_temperature_raw*/
+	} ds3231_sample_t;
+
+
+	/**
+	 * @brief Sample store data type. The oldest and the newest samples are kept as is, the samples between them as records in a ring buffer,
+	 * each the zig-zag varint delta of delta of the time and the zig-zag varint delta of the temperature from the sample before.
+	 *
+	 */
+	typedef struct
+	{
+		uint8_t buffer[DS3231_SAMPLE_STORE_SIZE];
+		uint16_t head;					/*Offset of the record of the second oldest sample*/
+		uint16_t used;					/*Bytes of records in the buffer from head on*/
+		uint16_t count;					/*Number of samples, one more than the records*/
+		ds3231_sample_t oldest;
+		int64_t oldest_interval;		/*Seconds from the sample before the oldest one, the record after it is decoded from it*/
+		ds3231_sample_t newest;
+		int64_t newest_interval;		/*Seconds from the sample before the newest one, the next record is encoded from it*/
+	} ds3231_sample_store_t;
+
+
+	/**
+	 * @brief Sample store cursor data type, the position of an iteration. It is valid until the next append to the store.
+	 *
+	 */
+	typedef struct
+	{
+		ds3231_sample_t sample;			/*The sample the cursor is on*/
+		int64_t interval;				/*Seconds from the sample before*/
+		uint16_t offset;				/*Going forward the offset of the record of the next sample, going backward the offset just after the record of the sample*/
+		uint16_t remaining;				/*Samples left in the direction of the iteration*/
+	} ds3231_sample_cursor_t;
+#endif
+
+
 	/**
 	 * @brief I2C address for DS3231. Use I2C_ADDRESS_NONE in case of software mock.
 	 *
@@ -518,12 +972,16 @@ extern "C"
 	 * @brief The handle to DS3231 instance
 	 *
 	 * The handle to an instance of DS3231 RTC module. Please set the correct dependency interface.
+	 * With the runtime policy feature, ds3231_init sets the policy to DS3231_POLICY_SAFE, so all the checks run by default.
 	 *
 	 */
 	typedef struct
 	{
 		ds3231_i2c_address_t i2c_address;
 		ds3231_interface_t interface;
+#if DS3231_INCLUDE_RUNTIME_POLICY
+		ds3231_policy_t policy;
+#endif
 	} ds3231_handle_t;
 
 
@@ -56,7 +56,7 @@ ds3231_error_code_t ds3231_alarm_2_init(const ds3231_handle_t *handle, const ds3
 	{
 	case DS3231_ALARM2_MATCH_MINUTE:
 	{
-		DS3231_RANGE_ERROR(config->minute, DS3231_MINUTES);
+		DS3231_RANGE_ERROR(handle, config->minute, DS3231_MINUTES);
 
 		uint8_t data = config->minute;
 		error = _ds3231_hex_to_bcd(&data);
@@ -75,8 +75,8 @@ ds3231_error_code_t ds3231_alarm_2_init(const ds3231_handle_t *handle, const ds3
 	}
 	case DS3231_ALARM2_MATCH_MINUTE_HOUR:
 	{
-		DS3231_RANGE_ERROR(config->minute, DS3231_MINUTES);
-		DS3231_RANGE_ERROR(config->hour, DS3231_HOURS);
+		DS3231_RANGE_ERROR(handle, config->minute, DS3231_MINUTES);
+		DS3231_RANGE_ERROR(handle, config->hour, DS3231_HOURS);
 
 		uint8_t data = config->minute;
 		error = _ds3231_hex_to_bcd(&data);
@@ -103,9 +103,9 @@ ds3231_error_code_t ds3231_alarm_2_init(const ds3231_handle_t *handle, const ds3
 	}
 	case DS3231_ALARM2_MATCH_MINUTE_HOUR_DATE:
 	{
-		DS3231_RANGE_ERROR(config->minute, DS3231_MINUTES);
-		DS3231_RANGE_ERROR(config->hour, DS3231_HOURS);
-		DS3231_RANGE_ERROR(config->day_date.date, DS3231_DATE);
+		DS3231_RANGE_ERROR(handle, config->minute, DS3231_MINUTES);
+		DS3231_RANGE_ERROR(handle, config->hour, DS3231_HOURS);
+		DS3231_RANGE_ERROR(handle, config->day_date.date, DS3231_DATE);
 
 		uint8_t data = config->minute;
 		error = _ds3231_hex_to_bcd(&data);
@@ -129,8 +129,9 @@ ds3231_error_code_t ds3231_alarm_2_init(const ds3231_handle_t *handle, const ds3
 		DS3231_UNLOCK(handle);
 		DS3231_VERIFY_BYTES(handle, error, DS3231_REGISTER_ALARM2_HOURS, &data, 1);
 
+		data = config->day_date.date;
 		error = _ds3231_hex_to_bcd(&data);
-		data = config->day_date.date & (~(1 << DS3231_BIT_DY_DT_ALARM2));
+		data &= (uint8_t)(~(1 << DS3231_BIT_DY_DT_ALARM2));
 		DS3231_LOCK(handle);
 		if (handle->interface.write_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM2_DAY_OF_WEEK_OR_DATE, &data, 1) != 0)
 		{
@@ -144,9 +145,9 @@ ds3231_error_code_t ds3231_alarm_2_init(const ds3231_handle_t *handle, const ds3
 	}
 	case DS3231_ALARM2_MATCH_MINUTE_HOUR_DAY:
 	{
-		DS3231_RANGE_ERROR(config->minute, DS3231_MINUTES);
-		DS3231_RANGE_ERROR(config->hour, DS3231_HOURS);
-		DS3231_RANGE_ERROR(config->day_date.day, DS3231_DAY);
+		DS3231_RANGE_ERROR(handle, config->minute, DS3231_MINUTES);
+		DS3231_RANGE_ERROR(handle, config->hour, DS3231_HOURS);
+		DS3231_RANGE_ERROR(handle, config->day_date.day, DS3231_DAY);
 
 		uint8_t data = config->minute;
 		error = _ds3231_hex_to_bcd(&data);
@@ -170,8 +171,9 @@ ds3231_error_code_t ds3231_alarm_2_init(const ds3231_handle_t *handle, const ds3
 		DS3231_UNLOCK(handle);
 		DS3231_VERIFY_BYTES(handle, error, DS3231_REGISTER_ALARM2_HOURS, &data, 1);
 
+		data = config->day_date.day;
 		error = _ds3231_hex_to_bcd(&data);
-		data = config->day_date.day | (1 << DS3231_BIT_DY_DT_ALARM2);
+		data |= (uint8_t)(1 << DS3231_BIT_DY_DT_ALARM2);
 		DS3231_LOCK(handle);
 		if (handle->interface.write_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM2_DAY_OF_WEEK_OR_DATE, &data, 1) != 0)
 		{
@@ -267,4 +269,147 @@ ds3231_error_code_t ds3231_alarm_2_flag_clear(const ds3231_handle_t *handle)
 	return DS3231_ERROR_OK;
 }
 
+/********************************************************/
+/********************************************************/
+void _ds3231_alarm_2_encode(const ds3231_alarm_2_config_t *config, uint8_t *data)
+{
+	data[0] = (uint8_t)config->minute;
+	data[1] = (uint8_t)config->hour;
+	data[2] = (uint8_t)((config->day_date_type == DS3231_ALARM_DAY) ? config->day_date.day : config->day_date.date);
+
+	/*The mask bit of each register is its most significant bit, the day/date select bit is only in the last one*/
+	for (uint8_t index = 0; index < DS3231_NUMBER_OF_ALARM_2_REGISTERS; index++)
+	{
+		_ds3231_hex_to_bcd(&data[index]);
+		data[index] |= (uint8_t)(DS3231_ALARM_2_MASK_BITS[(int)config->alarm_rate][index] << DS3231_BIT_A2M4);
+	}
+	data[DS3231_NUMBER_OF_ALARM_2_REGISTERS - 1] |= (uint8_t)(DS3231_ALARM_2_MASK_BITS[(int)config->alarm_rate][DS3231_NUMBER_OF_ALARM_2_REGISTERS] << DS3231_BIT_DY_DT_ALARM2);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_alarm_2_get_config(const ds3231_handle_t *handle, ds3231_alarm_2_config_t *config)
+{
+#if DS3231_INCLUDE_NULL_CHECK
+	ds3231_error_code_t error;
+#endif
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t data[DS3231_NUMBER_OF_ALARM_2_REGISTERS];
+
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM2_MINUTES, data, DS3231_NUMBER_OF_ALARM_2_REGISTERS) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+	DS3231_UNLOCK(handle);
+
+	return _ds3231_alarm_2_decode(data, config);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_alarm_2_decode(const uint8_t *data, ds3231_alarm_2_config_t *config)
+{
+	uint8_t last = data[DS3231_NUMBER_OF_ALARM_2_REGISTERS - 1];
+	ds3231_bool_t day_date_masked = (ds3231_bool_t)((last >> DS3231_BIT_A2M4) & 1);
+	ds3231_bool_t day_selected = (ds3231_bool_t)((last >> DS3231_BIT_DY_DT_ALARM2) & 1);
+	uint8_t rate;
+
+	/*The rate whose mask bits are the ones read, the day/date select bit only counts when the day/date is not masked*/
+	for (rate = 0; rate < (sizeof(DS3231_ALARM_2_MASK_BITS) / sizeof(DS3231_ALARM_2_MASK_BITS[0])); rate++)
+	{
+		uint8_t index;
+
+		for (index = 0; index < DS3231_NUMBER_OF_ALARM_2_REGISTERS; index++)
+		{
+			if (DS3231_ALARM_2_MASK_BITS[rate][index] != ((data[index] >> DS3231_BIT_A2M4) & 1))
+			{
+				break;
+			}
+		}
+
+		if ((index == DS3231_NUMBER_OF_ALARM_2_REGISTERS) && ((day_date_masked == DS3231_TRUE) || (DS3231_ALARM_2_MASK_BITS[rate][DS3231_NUMBER_OF_ALARM_2_REGISTERS] == day_selected)))
+		{
+			break;
+		}
+	}
+
+	if (rate == (sizeof(DS3231_ALARM_2_MASK_BITS) / sizeof(DS3231_ALARM_2_MASK_BITS[0])))
+	{
+		return DS3231_ERROR_ALARM_INVALID_MASK;
+	}
+
+	/*The minutes have 7 value bits, the hours 6 in 24 hour mode, the date 6 and the day 4*/
+	config->minute = _ds3231_alarm_register_value(data[0], 0x7F);
+	config->hour = _ds3231_alarm_register_value(data[1], 0x3F);
+	if (day_selected == DS3231_TRUE)
+	{
+		config->day_date.day = (ds3231_day_t)_ds3231_alarm_register_value(last, 0x0F);
+		config->day_date_type = DS3231_ALARM_DAY;
+	}
+	else
+	{
+		config->day_date.date = _ds3231_alarm_register_value(last, 0x3F);
+		config->day_date_type = DS3231_ALARM_DATE;
+	}
+	config->alarm_rate = (ds3231_alarm_2_rate_t)rate;
+
+	return DS3231_ERROR_OK;
+}
+
+#if DS3231_INCLUDE_CALENDAR
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_alarm_2_next_fire(const ds3231_alarm_2_config_t *config, const ds3231_epoch_t now, ds3231_epoch_t *next_fire)
+{
+	/*Alarm 2 has no seconds register, it fires at second 00 of the matching minute*/
+	ds3231_epoch_t second_of_day = (ds3231_epoch_t)config->hour * DS3231_SECONDS_PER_HOUR + (ds3231_epoch_t)config->minute * DS3231_SECONDS_PER_MINUTE;
+
+	/*Every rate but the date is periodic, with the match at a fixed offset into the period*/
+	switch (config->alarm_rate)
+	{
+	case DS3231_ALARM2_ONCE_PER_MINUTE:
+		*next_fire = _ds3231_next_periodic_match(now, DS3231_SECONDS_PER_MINUTE, 0);
+		break;
+	case DS3231_ALARM2_MATCH_MINUTE:
+		DS3231_VALUE_RANGE_ERROR(config->minute, DS3231_MINUTES);
+		*next_fire = _ds3231_next_periodic_match(now, DS3231_SECONDS_PER_HOUR, second_of_day % DS3231_SECONDS_PER_HOUR);
+		break;
+	case DS3231_ALARM2_MATCH_MINUTE_HOUR:
+		DS3231_VALUE_RANGE_ERROR(config->minute, DS3231_MINUTES);
+		DS3231_VALUE_RANGE_ERROR(config->hour, DS3231_HOURS);
+		*next_fire = _ds3231_next_periodic_match(now, DS3231_SECONDS_PER_DAY, second_of_day);
+		break;
+	case DS3231_ALARM2_MATCH_MINUTE_HOUR_DATE:
+		if (config->day_date_type == DS3231_ALARM_DAY)
+		{
+			return DS3231_ERROR_ALARM_RATE_AND_DAY_DATE_MISMATCH;
+		}
+		DS3231_VALUE_RANGE_ERROR(config->minute, DS3231_MINUTES);
+		DS3231_VALUE_RANGE_ERROR(config->hour, DS3231_HOURS);
+		DS3231_VALUE_RANGE_ERROR(config->day_date.date, DS3231_DATE);
+		return _ds3231_next_date_match(now, config->day_date.date, (int32_t)second_of_day, next_fire);
+	case DS3231_ALARM2_MATCH_MINUTE_HOUR_DAY:
+		if (config->day_date_type == DS3231_ALARM_DATE)
+		{
+			return DS3231_ERROR_ALARM_RATE_AND_DAY_DATE_MISMATCH;
+		}
+		DS3231_VALUE_RANGE_ERROR(config->minute, DS3231_MINUTES);
+		DS3231_VALUE_RANGE_ERROR(config->hour, DS3231_HOURS);
+		DS3231_VALUE_RANGE_ERROR(config->day_date.day, DS3231_DAY);
+		/*Day 0 of the epoch is a thursday, the week period starts there*/
+		*next_fire = _ds3231_next_periodic_match(now, (ds3231_epoch_t)DS3231_DAYS_PER_WEEK * DS3231_SECONDS_PER_DAY,
+												 (ds3231_epoch_t)((config->day_date.day - DS3231_EPOCH_DAY_OF_WEEK + DS3231_DAYS_PER_WEEK) % DS3231_DAYS_PER_WEEK) * DS3231_SECONDS_PER_DAY + second_of_day);
+		break;
+	default:
+		return DS3231_ERROR_ALARM_NEVER_MATCHES;
+	}
+
+	return DS3231_ERROR_OK;
+}
+#endif
+
 #endif
\ No newline at end of file
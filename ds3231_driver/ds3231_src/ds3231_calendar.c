@@ -0,0 +1,248 @@
+/**
+ * @file ds3231_calendar.c
+ * @brief DS3231 Real Time Clock C Driver
+ * @author Reza G. Ebrahimi <https://github.com/ebrezadev>
+ * @version 2.0
+ * @license MIT
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Reza G. Ebrahimi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "ds3231.h"
+#include "ds3231_macros.h"
+
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_CALENDAR
+int32_t _ds3231_days_from_civil(const ds3231_year_t year, const ds3231_month_t month, const ds3231_date_t date)
+{
+	/*Shift the year to start in march, so the leap day is the last day of the year*/
+	int32_t shifted_year = (int32_t)year - ((month <= DS3231_MONTH_FEBRUARY) ? 1 : 0);
+	int32_t era = shifted_year / 400;
+	int32_t year_of_era = shifted_year - era * 400;
+	int32_t shifted_month = (month > DS3231_MONTH_FEBRUARY) ? ((int32_t)month - 3) : ((int32_t)month + 9);
+	int32_t day_of_year = (153 * shifted_month + 2) / 5 + (int32_t)date - 1;
+	int32_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+
+	return era * DS3231_DAYS_PER_ERA + day_of_era - DS3231_DAYS_FROM_ERA_START_TO_EPOCH;
+}
+
+/********************************************************/
+/********************************************************/
+void _ds3231_civil_from_days(int32_t days, ds3231_time_and_calendar_t *time_struct)
+{
+	days += DS3231_DAYS_FROM_ERA_START_TO_EPOCH;
+
+	/*Eras are 400 years long, the supported range (1900 - 2099) never has a negative era*/
+	int32_t era = days / DS3231_DAYS_PER_ERA;
+	int32_t day_of_era = days - era * DS3231_DAYS_PER_ERA;
+	int32_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+	int32_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+	int32_t shifted_month = (5 * day_of_year + 2) / 153;
+	int32_t month = (shifted_month < 10) ? (shifted_month + 3) : (shifted_month - 9);
+
+	time_struct->date = (ds3231_date_t)(day_of_year - (153 * shifted_month + 2) / 5 + 1);
+	time_struct->month = (ds3231_month_t)month;
+	time_struct->year = (ds3231_year_t)(year_of_era + era * 400 + ((month <= DS3231_MONTH_FEBRUARY) ? 1 : 0));
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_day_t _ds3231_day_of_week_from_days(const int32_t days)
+{
+	/*Days before 1970 give a negative remainder, so bias it back into the range of 0 to 6*/
+	return (ds3231_day_t)(((days % 7) + 7 + (DS3231_EPOCH_DAY_OF_WEEK - 1)) % 7 + 1);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_day_of_week(const ds3231_year_t year, const ds3231_month_t month, const ds3231_date_t date, ds3231_day_t *day)
+{
+	DS3231_VALUE_RANGE_ERROR(month, DS3231_MONTH);
+	DS3231_VALUE_RANGE_ERROR(date, DS3231_DATE);
+
+	*day = _ds3231_day_of_week_from_days(_ds3231_days_from_civil(year, month, date));
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_time_and_calendar_to_epoch(const ds3231_time_and_calendar_t *time_struct, ds3231_epoch_t *epoch)
+{
+	DS3231_VALUE_RANGE_ERROR(time_struct->month, DS3231_MONTH);
+	DS3231_VALUE_RANGE_ERROR(time_struct->date, DS3231_DATE);
+
+	int32_t days = _ds3231_days_from_civil(time_struct->year, time_struct->month, time_struct->date);
+
+	*epoch = (ds3231_epoch_t)days * DS3231_SECONDS_PER_DAY +
+			 (ds3231_epoch_t)time_struct->hour * 3600 +
+			 (ds3231_epoch_t)time_struct->minute * 60 +
+			 (ds3231_epoch_t)time_struct->second;
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_epoch_to_time_and_calendar(const ds3231_epoch_t epoch, ds3231_time_and_calendar_t *time_struct)
+{
+	/*Floor division, so the epochs before 1970 land on the correct day*/
+	int32_t days = (int32_t)(epoch / DS3231_SECONDS_PER_DAY);
+	int32_t seconds_of_day = (int32_t)(epoch - (ds3231_epoch_t)days * DS3231_SECONDS_PER_DAY);
+
+	if (seconds_of_day < 0)
+	{
+		days -= 1;
+		seconds_of_day += DS3231_SECONDS_PER_DAY;
+	}
+
+	_ds3231_civil_from_days(days, time_struct);
+
+	time_struct->day = _ds3231_day_of_week_from_days(days);
+	time_struct->hour = (ds3231_hour_t)(seconds_of_day / 3600);
+	time_struct->minute = (ds3231_minute_t)((seconds_of_day / 60) % 60);
+	time_struct->second = (ds3231_second_t)(seconds_of_day % 60);
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_set_all_time_and_calendar_from_date(const ds3231_handle_t *handle, const ds3231_time_and_calendar_t *time_struct)
+{
+	/*Work on a copy, ds3231_set_all_time_and_calendar trims the year in place*/
+	ds3231_time_and_calendar_t time_copy = *time_struct;
+
+	/*Derive the day of week from the date, the day field of the caller is ignored*/
+	time_copy.day = _ds3231_day_of_week_from_days(_ds3231_days_from_civil(time_copy.year, time_copy.month, time_copy.date));
+
+	return ds3231_set_all_time_and_calendar(handle, &time_copy);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_set_all_time_and_calendar_from_epoch(const ds3231_handle_t *handle, const ds3231_epoch_t epoch)
+{
+	ds3231_time_and_calendar_t time_struct;
+
+	/*The conversion fills in the day of week as well*/
+	ds3231_epoch_to_time_and_calendar(epoch, &time_struct);
+
+	return ds3231_set_all_time_and_calendar(handle, &time_struct);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_epoch_t _ds3231_epoch_from_time_block(const uint8_t *data)
+{
+	uint8_t time_block[DS3231_NUMBER_OF_TIME_REGISTERS];
+
+	for (uint8_t index = 0; index < DS3231_NUMBER_OF_TIME_REGISTERS; index++)
+	{
+		time_block[index] = data[index];
+	}
+
+	/*The century bit is masked out by the conversion, so keep it first*/
+	ds3231_year_t century = ((data[DS3231_MONTH] >> DS3231_BIT_CENTURY) & 1) ? 1900 : 2000;
+
+	_ds3231_time_block_bcd_to_hex(time_block);
+
+	int32_t days = _ds3231_days_from_civil((ds3231_year_t)(century + time_block[DS3231_YEAR]), (ds3231_month_t)time_block[DS3231_MONTH], (ds3231_date_t)time_block[DS3231_DATE]);
+
+	return (ds3231_epoch_t)days * DS3231_SECONDS_PER_DAY + (ds3231_epoch_t)time_block[DS3231_HOURS] * 3600 + (ds3231_epoch_t)time_block[DS3231_MINUTES] * 60 + (ds3231_epoch_t)time_block[DS3231_SECONDS];
+}
+
+/********************************************************/
+/********************************************************/
+void _ds3231_time_block_from_time_and_calendar(const ds3231_time_and_calendar_t *time_struct, uint8_t *data)
+{
+	ds3231_bool_t century_bit = (time_struct->year < 2000) ? DS3231_TRUE : DS3231_FALSE;
+
+	data[DS3231_SECONDS] = (uint8_t)time_struct->second;
+	data[DS3231_MINUTES] = (uint8_t)time_struct->minute;
+	data[DS3231_HOURS] = (uint8_t)time_struct->hour;
+	data[DS3231_DAY] = (uint8_t)time_struct->day;
+	data[DS3231_DATE] = (uint8_t)time_struct->date;
+	data[DS3231_MONTH] = (uint8_t)time_struct->month;
+	data[DS3231_YEAR] = (uint8_t)(time_struct->year - ((century_bit == DS3231_TRUE) ? 1900 : 2000));
+
+	_ds3231_time_block_hex_to_bcd(data);
+
+	/*The 12/24 bit stays 0 for 24H format, the century bit is folded into the month*/
+	data[DS3231_MONTH] |= (uint8_t)(century_bit << DS3231_BIT_CENTURY);
+}
+
+#if DS3231_INCLUDE_ALARM_1 | DS3231_INCLUDE_ALARM_2
+/********************************************************/
+/********************************************************/
+ds3231_epoch_t _ds3231_next_periodic_match(const ds3231_epoch_t now, const ds3231_epoch_t period, const ds3231_epoch_t offset)
+{
+	/*Floor division, so the epochs before 1970 land on the correct period*/
+	ds3231_epoch_t elapsed = now - offset;
+	ds3231_epoch_t periods = elapsed / period;
+
+	if ((elapsed % period) < 0)
+	{
+		periods -= 1;
+	}
+
+	return offset + (periods + 1) * period;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_next_date_match(const ds3231_epoch_t now, const ds3231_date_t date, const int32_t second_of_day, ds3231_epoch_t *next_match)
+{
+	ds3231_time_and_calendar_t time_struct;
+	ds3231_epoch_to_time_and_calendar(now, &time_struct);
+
+	int32_t year = (int32_t)time_struct.year;
+	int32_t month = (int32_t)time_struct.month;
+
+	/*A date recurs within three months, the longest gap is from the 31st of January to the 31st of March*/
+	for (uint8_t step = 0; step < 3; step++)
+	{
+		int32_t next_year = (month == DS3231_MONTH_DECEMBER) ? (year + 1) : year;
+		int32_t next_month = (month == DS3231_MONTH_DECEMBER) ? DS3231_MONTH_JANUARY : (month + 1);
+		int32_t days = _ds3231_days_from_civil((ds3231_year_t)year, (ds3231_month_t)month, date);
+
+		/*Only the months that have the date, DS3231 skips the others*/
+		if (days < _ds3231_days_from_civil((ds3231_year_t)next_year, (ds3231_month_t)next_month, 1))
+		{
+			ds3231_epoch_t match = (ds3231_epoch_t)days * DS3231_SECONDS_PER_DAY + second_of_day;
+			if (match > now)
+			{
+				*next_match = match;
+				return DS3231_ERROR_OK;
+			}
+		}
+
+		year = next_year;
+		month = next_month;
+	}
+
+	return DS3231_ERROR_ALARM_NEVER_MATCHES;
+}
+#endif
+#endif
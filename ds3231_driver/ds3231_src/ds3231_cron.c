@@ -0,0 +1,528 @@
+/**
+ * @file ds3231_cron.c
+ * @brief DS3231 Real Time Clock C Driver
+ * @author Reza G. Ebrahimi <https://github.com/ebrezadev>
+ * @version 2.0
+ * @license MIT
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Reza G. Ebrahimi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "ds3231.h"
+#include "ds3231_macros.h"
+
+
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_CRON_ALARM
+ds3231_error_code_t ds3231_cron_compile(const char *expression, ds3231_cron_t *cron)
+{
+	ds3231_error_code_t error;
+	uint64_t bits[DS3231_CRON_NUMBER_OF_FIELDS];
+	ds3231_bool_t restricted[DS3231_CRON_NUMBER_OF_FIELDS];
+
+	for (uint8_t index = 0; index < DS3231_CRON_NUMBER_OF_FIELDS; index++)
+	{
+		while (*expression == ' ')
+		{
+			expression++;
+		}
+
+		error = _ds3231_cron_parse_field(&expression, &DS3231_CRON_FIELDS[index], &bits[index], &restricted[index]);
+		DS3231_CHECK_AND_RETURN_ERROR(error);
+	}
+
+	while (*expression == ' ')
+	{
+		expression++;
+	}
+	if (*expression != '\0')
+	{
+		return DS3231_ERROR_CRON_SYNTAX;
+	}
+
+	cron->minutes = bits[DS3231_CRON_MINUTE];
+	cron->hours = (uint32_t)bits[DS3231_CRON_HOUR];
+	cron->dates = (uint32_t)bits[DS3231_CRON_DATE];
+	cron->months = (uint16_t)bits[DS3231_CRON_MONTH];
+	cron->date_or_day = ((restricted[DS3231_CRON_DATE] == DS3231_TRUE) && (restricted[DS3231_CRON_DAY] == DS3231_TRUE)) ? DS3231_TRUE : DS3231_FALSE;
+
+	/*Cron counts the days of week from sunday as 0 or 7, DS3231 from monday as 1*/
+	cron->days = (uint8_t)(bits[DS3231_CRON_DAY] & 0XFE);
+	if (bits[DS3231_CRON_DAY] & 0X81)
+	{
+		cron->days |= (uint8_t)(1 << DS3231_DAY_SUNDAY);
+	}
+
+	/*The date has to match, some month must have one of the dates*/
+	if (cron->date_or_day == DS3231_FALSE)
+	{
+		ds3231_bool_t possible = DS3231_FALSE;
+		for (uint8_t month = DS3231_MONTH_JANUARY; month <= DS3231_MONTH_DECEMBER; month++)
+		{
+			if ((cron->months & (1 << month)) && (cron->dates & ((2UL << DS3231_CRON_LONGEST_MONTH[month]) - 2)))
+			{
+				possible = DS3231_TRUE;
+			}
+		}
+		if (possible == DS3231_FALSE)
+		{
+			return DS3231_ERROR_ALARM_NEVER_MATCHES;
+		}
+	}
+
+	/*Go down from the most specific rate, each one needs the fields it matches to hold a single value*/
+	uint8_t minute = _ds3231_cron_first_bit(cron->minutes, 0);
+	uint8_t hour = _ds3231_cron_first_bit(cron->hours, 0);
+	uint8_t date = _ds3231_cron_first_bit(cron->dates, 0);
+	uint8_t day = _ds3231_cron_first_bit(cron->days, 0);
+
+	/*Exactness comes from the bitmaps, a field starting with * may still be stepped, e.g. *\/15*/
+	ds3231_bool_t all_dates = (cron->dates == 0XFFFFFFFE) ? DS3231_TRUE : DS3231_FALSE;
+	ds3231_bool_t all_week = (cron->days == 0XFE) ? DS3231_TRUE : DS3231_FALSE;
+	ds3231_bool_t all_months = (cron->months == 0X1FFE) ? DS3231_TRUE : DS3231_FALSE;
+	ds3231_bool_t all_days = ((all_dates == DS3231_TRUE) && (all_week == DS3231_TRUE)) ? DS3231_TRUE : DS3231_FALSE;
+
+	cron->alarm.minute = (ds3231_minute_t)minute;
+	cron->alarm.hour = (ds3231_hour_t)hour;
+	cron->alarm.day_date.date = (ds3231_date_t)date;
+	cron->alarm.day_date_type = DS3231_ALARM_DATE;
+
+	if ((cron->minutes & (cron->minutes - 1)) != 0)
+	{
+		cron->alarm.alarm_rate = DS3231_ALARM2_ONCE_PER_MINUTE;
+		cron->exact = ((cron->minutes == 0XFFFFFFFFFFFFFFFULL) && (cron->hours == 0XFFFFFF) && (all_days == DS3231_TRUE) && (all_months == DS3231_TRUE)) ? DS3231_TRUE : DS3231_FALSE;
+	}
+	else if ((cron->hours & (cron->hours - 1)) != 0)
+	{
+		cron->alarm.alarm_rate = DS3231_ALARM2_MATCH_MINUTE;
+		cron->exact = ((cron->hours == 0XFFFFFF) && (all_days == DS3231_TRUE) && (all_months == DS3231_TRUE)) ? DS3231_TRUE : DS3231_FALSE;
+	}
+	else if ((restricted[DS3231_CRON_DATE] == DS3231_TRUE) && (restricted[DS3231_CRON_DAY] == DS3231_FALSE) && ((cron->dates & (cron->dates - 1)) == 0))
+	{
+		cron->alarm.alarm_rate = DS3231_ALARM2_MATCH_MINUTE_HOUR_DATE;
+		cron->exact = ((all_week == DS3231_TRUE) && (all_months == DS3231_TRUE)) ? DS3231_TRUE : DS3231_FALSE;
+	}
+	else if ((restricted[DS3231_CRON_DAY] == DS3231_TRUE) && (restricted[DS3231_CRON_DATE] == DS3231_FALSE) && ((cron->days & (cron->days - 1)) == 0))
+	{
+		cron->alarm.alarm_rate = DS3231_ALARM2_MATCH_MINUTE_HOUR_DAY;
+		cron->alarm.day_date.day = (ds3231_day_t)day;
+		cron->alarm.day_date_type = DS3231_ALARM_DAY;
+		cron->exact = ((all_dates == DS3231_TRUE) && (all_months == DS3231_TRUE)) ? DS3231_TRUE : DS3231_FALSE;
+	}
+	else
+	{
+		cron->alarm.alarm_rate = DS3231_ALARM2_MATCH_MINUTE_HOUR;
+		cron->exact = ((all_days == DS3231_TRUE) && (all_months == DS3231_TRUE)) ? DS3231_TRUE : DS3231_FALSE;
+	}
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_cron_matches(const ds3231_cron_t *cron, const ds3231_time_and_calendar_t *time_struct, ds3231_bool_t *match)
+{
+	*match = DS3231_FALSE;
+
+	if ((cron->minutes & (1ULL << time_struct->minute)) && (cron->hours & (1UL << time_struct->hour)))
+	{
+		*match = _ds3231_cron_day_matches(cron, time_struct->date, time_struct->month, time_struct->day);
+	}
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_cron_next_fire(const ds3231_cron_t *cron, const ds3231_epoch_t now, ds3231_epoch_t *next_fire)
+{
+	ds3231_epoch_t start = _ds3231_next_periodic_match(now, DS3231_SECONDS_PER_MINUTE, 0);
+	ds3231_time_and_calendar_t time_struct;
+
+	ds3231_epoch_to_time_and_calendar(start, &time_struct);
+
+	int32_t days = _ds3231_days_from_civil(time_struct.year, time_struct.month, time_struct.date);
+	uint8_t first_hour = (uint8_t)time_struct.hour;
+	uint8_t first_minute = (uint8_t)time_struct.minute;
+
+	for (int32_t step = 0; step < DS3231_CRON_SEARCH_DAYS; step++)
+	{
+		if (_ds3231_cron_day_matches(cron, time_struct.date, time_struct.month, time_struct.day) == DS3231_TRUE)
+		{
+			/*The first hour of the day with a minute left in it*/
+			for (uint8_t hour = _ds3231_cron_first_bit(cron->hours, first_hour); hour < 24; hour = _ds3231_cron_first_bit(cron->hours, (uint8_t)(hour + 1)))
+			{
+				uint8_t minute = _ds3231_cron_first_bit(cron->minutes, (hour == first_hour) ? first_minute : 0);
+				if (minute < 60)
+				{
+					*next_fire = (ds3231_epoch_t)days * DS3231_SECONDS_PER_DAY + (ds3231_epoch_t)hour * DS3231_SECONDS_PER_HOUR + (ds3231_epoch_t)minute * DS3231_SECONDS_PER_MINUTE;
+					return DS3231_ERROR_OK;
+				}
+			}
+		}
+
+		days++;
+		first_hour = 0;
+		first_minute = 0;
+		_ds3231_civil_from_days(days, &time_struct);
+		time_struct.day = _ds3231_day_of_week_from_days(days);
+	}
+
+	return DS3231_ERROR_ALARM_NEVER_MATCHES;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_cron_start(const ds3231_handle_t *handle, const ds3231_cron_t *cron)
+{
+	ds3231_bool_t due;
+
+	return _ds3231_cron_arm(handle, cron, DS3231_TRUE, &due);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_cron_check(const ds3231_handle_t *handle, const ds3231_cron_t *cron, ds3231_bool_t *due)
+{
+	return _ds3231_cron_arm(handle, cron, DS3231_FALSE, due);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_cron_arm(const ds3231_handle_t *handle, const ds3231_cron_t *cron, const ds3231_bool_t start, ds3231_bool_t *due)
+{
+	ds3231_error_code_t error;
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t data[DS3231_NUMBER_OF_REGISTERS_TO_STATUS];
+	ds3231_time_and_calendar_t time_struct;
+	uint8_t write_length = DS3231_CRON_ALARM_WRITE_LENGTH;
+
+	*due = DS3231_FALSE;
+
+	/*The lock is held from the read to the write, so the control and status registers written back are not stale*/
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_SECONDS, data, DS3231_NUMBER_OF_REGISTERS_TO_STATUS) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+
+	/*Alarm 1 may share the interrupt, leave everything alone if alarm 2 didn't fire*/
+	if ((start == DS3231_FALSE) && ((data[DS3231_REGISTER_CONTROL_STATUS] & (1 << DS3231_BIT_A2F)) == 0))
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_OK;
+	}
+
+	ds3231_epoch_t now = _ds3231_epoch_from_time_block(data);
+	ds3231_epoch_t fire = now;
+
+	/*The expression is matched at the time alarm 2 fired, from the registers before they are re-armed, so a late check still sees the fire*/
+	if (start == DS3231_FALSE)
+	{
+		error = _ds3231_cron_last_fire(&data[DS3231_REGISTER_ALARM2_MINUTES], now, &fire);
+		if (error != DS3231_ERROR_OK)
+		{
+			DS3231_UNLOCK(handle);
+			return error;
+		}
+	}
+	ds3231_epoch_to_time_and_calendar(fire, &time_struct);
+
+	if ((start == DS3231_TRUE) || (cron->exact == DS3231_FALSE))
+	{
+		ds3231_alarm_2_config_t config = cron->alarm;
+
+		/*Not exact, arm for the next match itself so there are no fires to filter*/
+		if (cron->exact == DS3231_FALSE)
+		{
+			ds3231_epoch_t next_fire;
+			ds3231_time_and_calendar_t next_struct;
+
+			error = ds3231_cron_next_fire(cron, now + DS3231_CRON_MIN_LEAD_S - 1, &next_fire);
+			if (error != DS3231_ERROR_OK)
+			{
+				DS3231_UNLOCK(handle);
+				return error;
+			}
+
+			ds3231_epoch_to_time_and_calendar(next_fire, &next_struct);
+			config.minute = next_struct.minute;
+			config.hour = next_struct.hour;
+			config.day_date.date = next_struct.date;
+			config.day_date_type = DS3231_ALARM_DATE;
+			config.alarm_rate = DS3231_ALARM2_MATCH_MINUTE_HOUR_DATE;
+		}
+		_ds3231_alarm_2_encode(&config, &data[DS3231_REGISTER_ALARM2_MINUTES]);
+	}
+	else
+	{
+		/*Exact, only the flag is cleared*/
+		write_length = 1;
+	}
+
+	/*Alarm 1 is left as read, CONV is not restarted. The flags can only be cleared, so A1F is written as 1 to not lose a fire since the read*/
+	data[DS3231_REGISTER_CONTROL] &= (uint8_t)(~(1 << DS3231_BIT_CONV));
+	if (start == DS3231_TRUE)
+	{
+		data[DS3231_REGISTER_CONTROL] |= (uint8_t)(1 << DS3231_BIT_A2IE);
+	}
+	data[DS3231_REGISTER_CONTROL_STATUS] &= (uint8_t)(~(1 << DS3231_BIT_A2F));
+	data[DS3231_REGISTER_CONTROL_STATUS] |= (uint8_t)(1 << DS3231_BIT_A1F);
+
+	uint8_t first_register = (uint8_t)(DS3231_REGISTER_CONTROL_STATUS + 1 - write_length);
+	if (handle->interface.write_array((uint8_t)handle->i2c_address, first_register, &data[first_register], write_length) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_WRITE;
+	}
+	DS3231_UNLOCK(handle);
+
+	if (write_length > 1)
+	{
+		DS3231_VERIFY_BYTES(handle, error, DS3231_REGISTER_ALARM2_MINUTES, &data[DS3231_REGISTER_ALARM2_MINUTES], DS3231_NUMBER_OF_ALARM_2_REGISTERS);
+	}
+
+	/*Filter the fires of a coarse rate that are not matches*/
+	if (start == DS3231_FALSE)
+	{
+		error = ds3231_cron_matches(cron, &time_struct, due);
+		DS3231_CHECK_AND_RETURN_ERROR(error);
+	}
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_cron_last_fire(const uint8_t *data, const ds3231_epoch_t now, ds3231_epoch_t *last_fire)
+{
+	ds3231_error_code_t error;
+	ds3231_alarm_2_config_t config;
+	ds3231_epoch_t period;
+	ds3231_epoch_t next_fire;
+
+	error = _ds3231_alarm_2_decode(data, &config);
+	DS3231_CHECK_AND_RETURN_ERROR(error);
+
+	switch (config.alarm_rate)
+	{
+	case DS3231_ALARM2_ONCE_PER_MINUTE:
+		period = DS3231_SECONDS_PER_MINUTE;
+		break;
+	case DS3231_ALARM2_MATCH_MINUTE:
+		period = DS3231_SECONDS_PER_HOUR;
+		break;
+	case DS3231_ALARM2_MATCH_MINUTE_HOUR:
+		period = DS3231_SECONDS_PER_DAY;
+		break;
+	case DS3231_ALARM2_MATCH_MINUTE_HOUR_DAY:
+		period = (ds3231_epoch_t)DS3231_DAYS_PER_WEEK * DS3231_SECONDS_PER_DAY;
+		break;
+	default:
+		period = (ds3231_epoch_t)DS3231_CRON_DATE_RECURRENCE_DAYS * DS3231_SECONDS_PER_DAY;
+		break;
+	}
+
+	/*The start of the minute if the registers were changed since the fire*/
+	*last_fire = _ds3231_next_periodic_match(now - DS3231_SECONDS_PER_MINUTE, DS3231_SECONDS_PER_MINUTE, 0);
+
+	/*Follow the fires from a period before now, the last one at or before now is the fire*/
+	error = ds3231_alarm_2_next_fire(&config, now - period, &next_fire);
+	while ((error == DS3231_ERROR_OK) && (next_fire <= now))
+	{
+		*last_fire = next_fire;
+		error = ds3231_alarm_2_next_fire(&config, next_fire, &next_fire);
+	}
+
+	return error;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_cron_parse_field(const char **cursor, const ds3231_cron_field_t *field, uint64_t *bits, ds3231_bool_t *restricted)
+{
+	ds3231_error_code_t error;
+
+	*bits = 0;
+	*restricted = (**cursor == '*') ? DS3231_FALSE : DS3231_TRUE;
+
+	for (;;)
+	{
+		uint8_t first;
+		uint8_t last;
+		uint8_t step = 1;
+
+		if (**cursor == '*')
+		{
+			first = field->minimum;
+			last = field->maximum;
+			(*cursor)++;
+		}
+		else
+		{
+			error = _ds3231_cron_parse_value(cursor, field, &first);
+			DS3231_CHECK_AND_RETURN_ERROR(error);
+			last = first;
+
+			if (**cursor == '-')
+			{
+				(*cursor)++;
+				error = _ds3231_cron_parse_value(cursor, field, &last);
+				DS3231_CHECK_AND_RETURN_ERROR(error);
+				if (last < first)
+				{
+					return DS3231_ERROR_CRON_SYNTAX;
+				}
+			}
+			else if (**cursor == '/')
+			{
+				/*A single value with a step runs to the end of the range*/
+				last = field->maximum;
+			}
+		}
+
+		if (**cursor == '/')
+		{
+			(*cursor)++;
+			error = _ds3231_cron_parse_value(cursor, NULL, &step);
+			DS3231_CHECK_AND_RETURN_ERROR(error);
+			if (step == 0)
+			{
+				return DS3231_ERROR_CRON_SYNTAX;
+			}
+		}
+
+		for (uint16_t value = first; value <= last; value += step)
+		{
+			*bits |= 1ULL << value;
+		}
+
+		if (**cursor != ',')
+		{
+			break;
+		}
+		(*cursor)++;
+	}
+
+	/*A field ends at a space or at the end of the expression*/
+	if ((**cursor != ' ') && (**cursor != '\0'))
+	{
+		return DS3231_ERROR_CRON_SYNTAX;
+	}
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_cron_parse_value(const char **cursor, const ds3231_cron_field_t *field, uint8_t *value)
+{
+	const char *text = *cursor;
+	uint16_t number = 0;
+
+	if ((*text >= '0') && (*text <= '9'))
+	{
+		while ((*text >= '0') && (*text <= '9'))
+		{
+			number = (uint16_t)(number * 10 + (*text - '0'));
+			if (number > 255)
+			{
+				return DS3231_ERROR_CRON_SYNTAX;
+			}
+			text++;
+		}
+	}
+	else if ((field != NULL) && (field->names != NULL))
+	{
+		/*Names are 3 letters, in any case*/
+		const char *name = field->names;
+		for (number = field->minimum; *name != '\0'; number++, name += 3)
+		{
+			if (((text[0] & 0XDF) == name[0]) && ((text[1] & 0XDF) == name[1]) && ((text[2] & 0XDF) == name[2]))
+			{
+				break;
+			}
+		}
+		if (*name == '\0')
+		{
+			return DS3231_ERROR_CRON_SYNTAX;
+		}
+		text += 3;
+	}
+	else
+	{
+		return DS3231_ERROR_CRON_SYNTAX;
+	}
+
+	if ((field != NULL) && ((number < field->minimum) || (number > field->maximum)))
+	{
+		return DS3231_ERROR_CRON_SYNTAX;
+	}
+
+	*value = (uint8_t)number;
+	*cursor = text;
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_bool_t _ds3231_cron_day_matches(const ds3231_cron_t *cron, const ds3231_date_t date, const ds3231_month_t month, const ds3231_day_t day)
+{
+	ds3231_bool_t date_match = (cron->dates & (1UL << date)) ? DS3231_TRUE : DS3231_FALSE;
+	ds3231_bool_t day_match = (cron->days & (1 << day)) ? DS3231_TRUE : DS3231_FALSE;
+
+	if ((cron->months & (1 << month)) == 0)
+	{
+		return DS3231_FALSE;
+	}
+
+	/*Vixie cron: if both start with something else than * either one matches, otherwise both do*/
+	if (cron->date_or_day == DS3231_TRUE)
+	{
+		return ((date_match == DS3231_TRUE) || (day_match == DS3231_TRUE)) ? DS3231_TRUE : DS3231_FALSE;
+	}
+
+	return ((date_match == DS3231_TRUE) && (day_match == DS3231_TRUE)) ? DS3231_TRUE : DS3231_FALSE;
+}
+
+/********************************************************/
+/********************************************************/
+uint8_t _ds3231_cron_first_bit(const uint64_t bits, const uint8_t from)
+{
+	for (uint8_t index = from; index < 64; index++)
+	{
+		if (bits & (1ULL << index))
+		{
+			return index;
+		}
+	}
+
+	return 64;
+}
+
+#endif
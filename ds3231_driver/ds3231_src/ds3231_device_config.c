@@ -0,0 +1,357 @@
+/**
+ * @file ds3231_device_config.c
+ * @brief DS3231 Real Time Clock C Driver
+ * @author Reza G. Ebrahimi <https://github.com/ebrezadev>
+ * @version 2.0
+ * @license MIT
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Reza G. Ebrahimi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "ds3231.h"
+#include "ds3231_macros.h"
+
+
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_DEVICE_CONFIG
+ds3231_error_code_t ds3231_apply_config(const ds3231_handle_t *handle, const ds3231_device_config_t *config, ds3231_config_part_mask_t *changes)
+{
+	ds3231_error_code_t error;
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t image[DS3231_DEVICE_CONFIG_LENGTH];
+	uint8_t care[DS3231_DEVICE_CONFIG_LENGTH];
+
+	error = _ds3231_device_config_encode(handle, config, image, care);
+	DS3231_CHECK_AND_RETURN_ERROR(error);
+
+	return _ds3231_device_config_reconcile(handle, image, care, changes);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_device_config_encode(const ds3231_handle_t *handle, const ds3231_device_config_t *config, uint8_t *image, uint8_t *care)
+{
+	/*The handle only selects the policy of the range checks, which may be compiled out*/
+	(void)handle;
+
+	const uint8_t control = DS3231_REGISTER_CONTROL - DS3231_REGISTER_ALARM1_SECONDS;
+	const uint8_t status = DS3231_REGISTER_CONTROL_STATUS - DS3231_REGISTER_ALARM1_SECONDS;
+
+	for (uint8_t index = 0; index < DS3231_DEVICE_CONFIG_LENGTH; index++)
+	{
+		image[index] = 0;
+		care[index] = 0;
+	}
+
+	image[control] = (uint8_t)((config->battery_backed_oscillator << DS3231_BIT_EOSC) | (config->battery_backed_sqw << DS3231_BIT_BBSQW) |
+							   ((config->sqw_frequency & 3) << DS3231_BIT_RS1) | (config->int_sqw_pin << DS3231_BIT_INTCN));
+	care[control] = (uint8_t)((1 << DS3231_BIT_EOSC) | (1 << DS3231_BIT_BBSQW) | (1 << DS3231_BIT_RS2) | (1 << DS3231_BIT_RS1) | (1 << DS3231_BIT_INTCN));
+
+	image[status] = (uint8_t)(config->wave_32khz << DS3231_BIT_EN32KHZ);
+	care[status] = (uint8_t)(1 << DS3231_BIT_EN32KHZ);
+
+#if DS3231_INCLUDE_AGING_OFFSET_CALIBRATION
+	image[DS3231_REGISTER_AGING_OFFSET - DS3231_REGISTER_ALARM1_SECONDS] = (uint8_t)config->aging_offset;
+	care[DS3231_REGISTER_AGING_OFFSET - DS3231_REGISTER_ALARM1_SECONDS] = 0XFF;
+#endif
+
+#if DS3231_INCLUDE_ALARM_1
+	const ds3231_alarm_1_config_t *alarm_1 = &config->alarm_1;
+	const uint8_t *alarm_1_mask = DS3231_ALARM_1_MASK_BITS[(int)alarm_1->alarm_rate];
+
+	if (((alarm_1->day_date_type == DS3231_ALARM_DAY) && (alarm_1->alarm_rate == DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR_DATE)) ||
+		((alarm_1->day_date_type == DS3231_ALARM_DATE) && (alarm_1->alarm_rate == DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR_DAY)))
+	{
+		return DS3231_ERROR_ALARM_RATE_AND_DAY_DATE_MISMATCH;
+	}
+
+	/*Only the fields the rate matches are range checked, as in ds3231_alarm_1_init*/
+	if (alarm_1_mask[0] == 0)
+	{
+		DS3231_RANGE_ERROR(handle, alarm_1->second, DS3231_SECONDS);
+	}
+	if (alarm_1_mask[1] == 0)
+	{
+		DS3231_RANGE_ERROR(handle, alarm_1->minute, DS3231_MINUTES);
+	}
+	if (alarm_1_mask[2] == 0)
+	{
+		DS3231_RANGE_ERROR(handle, alarm_1->hour, DS3231_HOURS);
+	}
+	if ((alarm_1_mask[3] == 0) && (alarm_1->day_date_type == DS3231_ALARM_DAY))
+	{
+		DS3231_RANGE_ERROR(handle, alarm_1->day_date.day, DS3231_DAY);
+	}
+	if ((alarm_1_mask[3] == 0) && (alarm_1->day_date_type == DS3231_ALARM_DATE))
+	{
+		DS3231_RANGE_ERROR(handle, alarm_1->day_date.date, DS3231_DATE);
+	}
+
+	/*A masked register only cares for its mask bit, whatever value it holds*/
+	_ds3231_alarm_1_encode(alarm_1, image);
+	for (uint8_t index = 0; index < DS3231_NUMBER_OF_ALARM_1_REGISTERS; index++)
+	{
+		care[index] = (alarm_1_mask[index] == 0) ? 0XFF : (uint8_t)(1 << DS3231_BIT_A1M4);
+	}
+
+	image[control] |= (uint8_t)(config->alarm_1_interrupt << DS3231_BIT_A1IE);
+	care[control] |= (uint8_t)(1 << DS3231_BIT_A1IE);
+#endif
+
+#if DS3231_INCLUDE_ALARM_2
+	const ds3231_alarm_2_config_t *alarm_2 = &config->alarm_2;
+	const uint8_t *alarm_2_mask = DS3231_ALARM_2_MASK_BITS[(int)alarm_2->alarm_rate];
+	uint8_t *alarm_2_image = &image[DS3231_REGISTER_ALARM2_MINUTES - DS3231_REGISTER_ALARM1_SECONDS];
+	uint8_t *alarm_2_care = &care[DS3231_REGISTER_ALARM2_MINUTES - DS3231_REGISTER_ALARM1_SECONDS];
+
+	if (((alarm_2->day_date_type == DS3231_ALARM_DAY) && (alarm_2->alarm_rate == DS3231_ALARM2_MATCH_MINUTE_HOUR_DATE)) ||
+		((alarm_2->day_date_type == DS3231_ALARM_DATE) && (alarm_2->alarm_rate == DS3231_ALARM2_MATCH_MINUTE_HOUR_DAY)))
+	{
+		return DS3231_ERROR_ALARM_RATE_AND_DAY_DATE_MISMATCH;
+	}
+
+	if (alarm_2_mask[0] == 0)
+	{
+		DS3231_RANGE_ERROR(handle, alarm_2->minute, DS3231_MINUTES);
+	}
+	if (alarm_2_mask[1] == 0)
+	{
+		DS3231_RANGE_ERROR(handle, alarm_2->hour, DS3231_HOURS);
+	}
+	if ((alarm_2_mask[2] == 0) && (alarm_2->day_date_type == DS3231_ALARM_DAY))
+	{
+		DS3231_RANGE_ERROR(handle, alarm_2->day_date.day, DS3231_DAY);
+	}
+	if ((alarm_2_mask[2] == 0) && (alarm_2->day_date_type == DS3231_ALARM_DATE))
+	{
+		DS3231_RANGE_ERROR(handle, alarm_2->day_date.date, DS3231_DATE);
+	}
+
+	_ds3231_alarm_2_encode(alarm_2, alarm_2_image);
+	for (uint8_t index = 0; index < DS3231_NUMBER_OF_ALARM_2_REGISTERS; index++)
+	{
+		alarm_2_care[index] = (alarm_2_mask[index] == 0) ? 0XFF : (uint8_t)(1 << DS3231_BIT_A2M4);
+	}
+
+	image[control] |= (uint8_t)(config->alarm_2_interrupt << DS3231_BIT_A2IE);
+	care[control] |= (uint8_t)(1 << DS3231_BIT_A2IE);
+#endif
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_device_config_reconcile(const ds3231_handle_t *handle, const uint8_t *image, const uint8_t *care, ds3231_config_part_mask_t *changes)
+{
+	uint8_t data[DS3231_DEVICE_CONFIG_LENGTH];
+	uint16_t differing = 0;
+	uint8_t first = 0;
+
+	*changes = 0;
+
+	/*The lock is held up to the last write, so the registers written back as read are not stale*/
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM1_SECONDS, data, DS3231_DEVICE_CONFIG_LENGTH) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+
+	for (uint8_t index = 0; index < DS3231_DEVICE_CONFIG_LENGTH; index++)
+	{
+		if (((data[index] ^ image[index]) & care[index]) != 0)
+		{
+			differing |= (uint16_t)(1 << index);
+			*changes |= DS3231_DEVICE_CONFIG_PARTS[index];
+		}
+		data[index] = (uint8_t)((data[index] & ~care[index]) | (image[index] & care[index]));
+	}
+
+	/*CONV is not restarted. The alarm flags are written as 1 to not lose a fire since the read, the oscillator stop flag as read*/
+	data[DS3231_REGISTER_CONTROL - DS3231_REGISTER_ALARM1_SECONDS] &= (uint8_t)(~(1 << DS3231_BIT_CONV));
+	data[DS3231_REGISTER_CONTROL_STATUS - DS3231_REGISTER_ALARM1_SECONDS] |= (uint8_t)((1 << DS3231_BIT_A1F) | (1 << DS3231_BIT_A2F));
+
+	/*One write per run of differing registers. Up to DS3231_I2C_WRITE_OVERHEAD_BYTES registers between two runs are cheaper written again than another write*/
+	while (first < DS3231_DEVICE_CONFIG_LENGTH)
+	{
+		if (((differing >> first) & 1) == 0)
+		{
+			first++;
+			continue;
+		}
+
+		uint8_t last = first;
+		for (uint8_t next = first + 1; (next < DS3231_DEVICE_CONFIG_LENGTH) && (next - last - 1 <= DS3231_I2C_WRITE_OVERHEAD_BYTES); next++)
+		{
+			if (((differing >> next) & 1) != 0)
+			{
+				last = next;
+			}
+		}
+
+		if (handle->interface.write_array((uint8_t)handle->i2c_address, (uint8_t)(DS3231_REGISTER_ALARM1_SECONDS + first), &data[first], (uint8_t)(last - first + 1)) != 0)
+		{
+			DS3231_UNLOCK(handle);
+			return DS3231_ERROR_INTERFACE_WRITE;
+		}
+
+		first = (uint8_t)(last + 1);
+	}
+	DS3231_UNLOCK(handle);
+
+#if DS3231_INCLUDE_WRITE_VERIFICATION
+	/*The flags may change on their own, so only the cared bits are verified, in one read back*/
+	if ((differing != 0) && DS3231_POLICY_ENABLED(handle, DS3231_POLICY_SKIP_WRITE_VERIFICATION))
+	{
+		DS3231_LOCK(handle);
+		if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM1_SECONDS, data, DS3231_DEVICE_CONFIG_LENGTH) != 0)
+		{
+			DS3231_UNLOCK(handle);
+			return DS3231_ERROR_INTERFACE_READ;
+		}
+		DS3231_UNLOCK(handle);
+
+		for (uint8_t index = 0; index < DS3231_DEVICE_CONFIG_LENGTH; index++)
+		{
+			if (((data[index] ^ image[index]) & care[index]) != 0)
+			{
+				return DS3231_ERROR_VERIFICATION_FAIL;
+			}
+		}
+	}
+#endif
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_config_save(const ds3231_handle_t *handle, ds3231_config_blob_t *blob)
+{
+#if DS3231_INCLUDE_NULL_CHECK
+	ds3231_error_code_t error;
+#endif
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM1_SECONDS, blob->data, DS3231_DEVICE_CONFIG_LENGTH) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+	DS3231_UNLOCK(handle);
+
+	for (uint8_t index = 0; index < DS3231_DEVICE_CONFIG_LENGTH; index++)
+	{
+		blob->data[index] &= DS3231_CONFIG_BLOB_MASK[index];
+	}
+
+	uint16_t crc = _ds3231_config_blob_crc(blob->data, DS3231_DEVICE_CONFIG_LENGTH);
+	blob->data[DS3231_DEVICE_CONFIG_LENGTH] = (uint8_t)(crc >> 8);
+	blob->data[DS3231_DEVICE_CONFIG_LENGTH + 1] = (uint8_t)crc;
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_config_restore(const ds3231_handle_t *handle, const ds3231_config_blob_t *blob)
+{
+#if DS3231_INCLUDE_NULL_CHECK
+	ds3231_error_code_t error;
+#endif
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t data[DS3231_DEVICE_CONFIG_LENGTH];
+	uint16_t crc = _ds3231_config_blob_crc(blob->data, DS3231_DEVICE_CONFIG_LENGTH);
+
+	if ((blob->data[DS3231_DEVICE_CONFIG_LENGTH] != (uint8_t)(crc >> 8)) || (blob->data[DS3231_DEVICE_CONFIG_LENGTH + 1] != (uint8_t)crc))
+	{
+		return DS3231_ERROR_CONFIG_BLOB_CRC;
+	}
+
+	/*The flags are written as 1, which can't set them, so a replaced DS3231 still reports its stopped oscillator*/
+	for (uint8_t index = 0; index < DS3231_DEVICE_CONFIG_LENGTH; index++)
+	{
+		data[index] = blob->data[index] & DS3231_CONFIG_BLOB_MASK[index];
+	}
+	data[DS3231_REGISTER_CONTROL_STATUS - DS3231_REGISTER_ALARM1_SECONDS] |= (uint8_t)((1 << DS3231_BIT_OSF) | (1 << DS3231_BIT_A2F) | (1 << DS3231_BIT_A1F));
+
+	DS3231_LOCK(handle);
+	if (handle->interface.write_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM1_SECONDS, data, DS3231_DEVICE_CONFIG_LENGTH) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_WRITE;
+	}
+	DS3231_UNLOCK(handle);
+
+#if DS3231_INCLUDE_WRITE_VERIFICATION
+	/*The flags may change on their own, so only the bits of the blob are verified*/
+	if (DS3231_POLICY_ENABLED(handle, DS3231_POLICY_SKIP_WRITE_VERIFICATION))
+	{
+		DS3231_LOCK(handle);
+		if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM1_SECONDS, data, DS3231_DEVICE_CONFIG_LENGTH) != 0)
+		{
+			DS3231_UNLOCK(handle);
+			return DS3231_ERROR_INTERFACE_READ;
+		}
+		DS3231_UNLOCK(handle);
+
+		for (uint8_t index = 0; index < DS3231_DEVICE_CONFIG_LENGTH; index++)
+		{
+			if (((data[index] ^ blob->data[index]) & DS3231_CONFIG_BLOB_MASK[index]) != 0)
+			{
+				return DS3231_ERROR_VERIFICATION_FAIL;
+			}
+		}
+	}
+#endif
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+uint16_t _ds3231_config_blob_crc(const uint8_t *data, const uint8_t number_of_bytes)
+{
+	uint16_t crc = DS3231_CONFIG_BLOB_CRC_INITIAL;
+
+	for (uint8_t index = 0; index < number_of_bytes; index++)
+	{
+		crc ^= (uint16_t)(data[index] << 8);
+		for (uint8_t bit = 0; bit < 8; bit++)
+		{
+			crc = (uint16_t)((crc & 0X8000) ? ((crc << 1) ^ DS3231_CONFIG_BLOB_CRC_POLYNOMIAL) : (crc << 1));
+		}
+	}
+
+	return crc;
+}
+
+#endif
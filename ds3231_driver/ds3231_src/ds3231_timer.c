@@ -0,0 +1,361 @@
+/**
+ * @file ds3231_timer.c
+ * @brief DS3231 Real Time Clock C Driver
+ * @author Reza G. Ebrahimi <https://github.com/ebrezadev>
+ * @version 2.0
+ * @license MIT
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Reza G. Ebrahimi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "ds3231.h"
+#include "ds3231_macros.h"
+
+
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_TIMER_SERVICE
+ds3231_error_code_t ds3231_timer_service_init(const ds3231_handle_t *handle, ds3231_timer_service_t *service, const ds3231_timer_alarm_t alarm)
+{
+	ds3231_error_code_t error;
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	service->count = 0;
+	service->alarm = alarm;
+	service->programmed = DS3231_TIMER_NOT_PROGRAMMED;
+	service->dispatching = DS3231_FALSE;
+
+	switch (alarm)
+	{
+#if DS3231_INCLUDE_ALARM_1
+	case DS3231_TIMER_ALARM_1:
+		error = ds3231_alarm_1_flag_clear(handle);
+		DS3231_CHECK_AND_RETURN_ERROR(error);
+		error = ds3231_alarm_1_interrupt_control(handle, DS3231_TRUE);
+		DS3231_CHECK_AND_RETURN_ERROR(error);
+		break;
+#endif
+#if DS3231_INCLUDE_ALARM_2
+	case DS3231_TIMER_ALARM_2:
+		error = ds3231_alarm_2_flag_clear(handle);
+		DS3231_CHECK_AND_RETURN_ERROR(error);
+		error = ds3231_alarm_2_interrupt_control(handle, DS3231_TRUE);
+		DS3231_CHECK_AND_RETURN_ERROR(error);
+		break;
+#endif
+	default:
+		break;
+	}
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+void ds3231_timer_init(ds3231_timer_t *timer, ds3231_timer_callback_fp callback, void *context)
+{
+	timer->deadline = 0;
+	timer->period = 0;
+	timer->callback = callback;
+	timer->context = context;
+	timer->heap_index = DS3231_TIMER_NOT_QUEUED;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_timer_start(const ds3231_handle_t *handle, ds3231_timer_service_t *service, ds3231_timer_t *timer, const ds3231_epoch_t deadline, const uint32_t period)
+{
+	timer->period = period;
+
+	if (timer->heap_index != DS3231_TIMER_NOT_QUEUED)
+	{
+		/*Already started, move it up or down to its new place*/
+		timer->deadline = deadline;
+		_ds3231_timer_heap_up(service, timer->heap_index);
+		_ds3231_timer_heap_down(service, timer->heap_index);
+	}
+	else
+	{
+		if (service->count >= DS3231_TIMER_SERVICE_CAPACITY)
+		{
+			return DS3231_ERROR_TIMER_SERVICE_FULL;
+		}
+
+		timer->deadline = deadline;
+		timer->heap_index = service->count;
+		service->heap[service->count++] = timer;
+		_ds3231_timer_heap_up(service, timer->heap_index);
+	}
+
+	return _ds3231_timer_service_program(handle, service);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_timer_cancel(const ds3231_handle_t *handle, ds3231_timer_service_t *service, ds3231_timer_t *timer)
+{
+	if (timer->heap_index == DS3231_TIMER_NOT_QUEUED)
+	{
+		return DS3231_ERROR_OK;
+	}
+
+	_ds3231_timer_heap_remove(service, timer);
+
+	return _ds3231_timer_service_program(handle, service);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_timer_service_dispatch(const ds3231_handle_t *handle, ds3231_timer_service_t *service)
+{
+	ds3231_error_code_t error;
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	/*Clear the flag first, so a fire during the dispatch is not lost*/
+	switch (service->alarm)
+	{
+#if DS3231_INCLUDE_ALARM_1
+	case DS3231_TIMER_ALARM_1:
+		error = ds3231_alarm_1_flag_clear(handle);
+		break;
+#endif
+#if DS3231_INCLUDE_ALARM_2
+	case DS3231_TIMER_ALARM_2:
+		error = ds3231_alarm_2_flag_clear(handle);
+		break;
+#endif
+	default:
+		error = DS3231_ERROR_OK;
+		break;
+	}
+	DS3231_CHECK_AND_RETURN_ERROR(error);
+
+	uint8_t data[DS3231_NUMBER_OF_TIME_REGISTERS];
+
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_SECONDS, data, DS3231_NUMBER_OF_TIME_REGISTERS) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+	DS3231_UNLOCK(handle);
+
+	ds3231_epoch_t now = _ds3231_epoch_from_time_block(data);
+
+	/*The alarm has fired, whatever deadline was in it is used up*/
+	service->programmed = DS3231_TIMER_NOT_PROGRAMMED;
+	service->dispatching = DS3231_TRUE;
+
+	while ((service->count > 0) && (service->heap[0]->deadline <= now))
+	{
+		ds3231_timer_t *timer = service->heap[0];
+
+		if (timer->period != 0)
+		{
+			/*Skip the periods missed while the alarm was not served, then move the timer down in place*/
+			timer->deadline += (ds3231_epoch_t)timer->period * ((now - timer->deadline) / timer->period + 1);
+			_ds3231_timer_heap_down(service, 0);
+		}
+		else
+		{
+			_ds3231_timer_heap_remove(service, timer);
+		}
+
+		if (timer->callback != NULL)
+		{
+			timer->callback(timer->context);
+		}
+	}
+
+	service->dispatching = DS3231_FALSE;
+
+	return _ds3231_timer_service_program(handle, service);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_timer_service_program(const ds3231_handle_t *handle, ds3231_timer_service_t *service)
+{
+	if ((service->dispatching == DS3231_TRUE) || (service->count == 0) || (service->heap[0]->deadline == service->programmed))
+	{
+		return DS3231_ERROR_OK;
+	}
+
+	ds3231_error_code_t error;
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t data[DS3231_NUMBER_OF_TIME_REGISTERS];
+
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_SECONDS, data, DS3231_NUMBER_OF_TIME_REGISTERS) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+	DS3231_UNLOCK(handle);
+
+	/*A deadline that is due or too close is moved a little ahead, the alarm would otherwise only match a month later*/
+	ds3231_epoch_t deadline = service->heap[0]->deadline;
+	ds3231_epoch_t earliest = _ds3231_epoch_from_time_block(data) + DS3231_TIMER_MIN_LEAD_S;
+	ds3231_epoch_t target = (deadline > earliest) ? deadline : earliest;
+	ds3231_time_and_calendar_t time_struct;
+
+	switch (service->alarm)
+	{
+#if DS3231_INCLUDE_ALARM_1
+	case DS3231_TIMER_ALARM_1:
+	{
+		ds3231_epoch_to_time_and_calendar(target, &time_struct);
+
+		ds3231_alarm_1_config_t config;
+		config.second = time_struct.second;
+		config.minute = time_struct.minute;
+		config.hour = time_struct.hour;
+		config.day_date.date = time_struct.date;
+		config.day_date_type = DS3231_ALARM_DATE;
+		config.alarm_rate = DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR_DATE;
+
+		error = ds3231_alarm_1_init(handle, &config);
+		DS3231_CHECK_AND_RETURN_ERROR(error);
+		break;
+	}
+#endif
+#if DS3231_INCLUDE_ALARM_2
+	case DS3231_TIMER_ALARM_2:
+	{
+		/*Round up to the next full minute*/
+		ds3231_epoch_t remainder = target % DS3231_SECONDS_PER_MINUTE;
+		if (remainder < 0)
+		{
+			remainder += DS3231_SECONDS_PER_MINUTE;
+		}
+		if (remainder != 0)
+		{
+			target += DS3231_SECONDS_PER_MINUTE - remainder;
+		}
+
+		ds3231_epoch_to_time_and_calendar(target, &time_struct);
+
+		ds3231_alarm_2_config_t config;
+		config.minute = time_struct.minute;
+		config.hour = time_struct.hour;
+		config.day_date.date = time_struct.date;
+		config.day_date_type = DS3231_ALARM_DATE;
+		config.alarm_rate = DS3231_ALARM2_MATCH_MINUTE_HOUR_DATE;
+
+		error = ds3231_alarm_2_init(handle, &config);
+		DS3231_CHECK_AND_RETURN_ERROR(error);
+		break;
+	}
+#endif
+	default:
+		break;
+	}
+
+	service->programmed = deadline;
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+void _ds3231_timer_heap_up(ds3231_timer_service_t *service, uint16_t index)
+{
+	ds3231_timer_t *timer = service->heap[index];
+
+	while (index > 0)
+	{
+		uint16_t parent = (uint16_t)((index - 1) / 2);
+		if (service->heap[parent]->deadline <= timer->deadline)
+		{
+			break;
+		}
+
+		service->heap[index] = service->heap[parent];
+		service->heap[index]->heap_index = index;
+		index = parent;
+	}
+
+	service->heap[index] = timer;
+	timer->heap_index = index;
+}
+
+/********************************************************/
+/********************************************************/
+void _ds3231_timer_heap_down(ds3231_timer_service_t *service, uint16_t index)
+{
+	ds3231_timer_t *timer = service->heap[index];
+
+	for (;;)
+	{
+		uint16_t child = (uint16_t)(2 * index + 1);
+		if (child >= service->count)
+		{
+			break;
+		}
+
+		/*Take the earlier of the two children*/
+		if (((child + 1) < service->count) && (service->heap[child + 1]->deadline < service->heap[child]->deadline))
+		{
+			child++;
+		}
+
+		if (timer->deadline <= service->heap[child]->deadline)
+		{
+			break;
+		}
+
+		service->heap[index] = service->heap[child];
+		service->heap[index]->heap_index = index;
+		index = child;
+	}
+
+	service->heap[index] = timer;
+	timer->heap_index = index;
+}
+
+/********************************************************/
+/********************************************************/
+void _ds3231_timer_heap_remove(ds3231_timer_service_t *service, ds3231_timer_t *timer)
+{
+	uint16_t index = timer->heap_index;
+
+	timer->heap_index = DS3231_TIMER_NOT_QUEUED;
+	service->count--;
+
+	/*Fill the hole with the last timer and restore the heap around it*/
+	if (index != service->count)
+	{
+		ds3231_timer_t *moved = service->heap[service->count];
+
+		service->heap[index] = moved;
+		moved->heap_index = index;
+		_ds3231_timer_heap_up(service, index);
+		_ds3231_timer_heap_down(service, moved->heap_index);
+	}
+}
+
+#endif
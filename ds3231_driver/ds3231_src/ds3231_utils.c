@@ -95,8 +95,12 @@ ds3231_error_code_t _ds3231_bit_set(
 /********************************************************/
 ds3231_error_code_t _ds3231_bcd_to_hex(uint8_t *data)
 {
+#if DS3231_INCLUDE_BCD_SWAR
 	/*Instead of multiplying in 10, we use shift operation for speed*/
 	*data = ((*data >> 4) << 1) + ((*data >> 4) << 3) + (*data & 0X0F);
+#else
+	*data = DS3231_BCD_TENS_LUT[*data >> 4] + (*data & 0X0F);
+#endif
 
 	return DS3231_ERROR_OK;
 }
@@ -105,11 +109,197 @@ ds3231_error_code_t _ds3231_bcd_to_hex(uint8_t *data)
 /********************************************************/
 ds3231_error_code_t _ds3231_hex_to_bcd(uint8_t *data)
 {
-	*data = (((*data) / 10) << 4) + ((*data) - ((*data) / 10) * 10);
+#if DS3231_INCLUDE_BCD_SWAR
+	/*(data * 103) >> 10 equals data / 10 for 0 to 99, and BCD is data + 6 * tens*/
+	*data = (uint8_t)(*data + 6 * ((*data * 103) >> 10));
+#else
+	/*Values above 99 can not be represented in BCD and are left as is*/
+	if (*data < 100)
+	{
+		*data = DS3231_HEX_TO_BCD_LUT[*data];
+	}
+#endif
 
 	return DS3231_ERROR_OK;
 }
 
+/********************************************************/
+/********************************************************/
+int16_t _ds3231_temperature_raw(const uint8_t *data)
+{
+	/*A 10 bit two's complement number, the integer part with the sign in the MSB and the quarters in the top 2 bits of the LSB*/
+	return (int16_t)((int8_t)data[0] * 4 + (data[1] >> 6));
+}
+
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_ALARM_1 | DS3231_INCLUDE_ALARM_2
+uint8_t _ds3231_alarm_register_value(const uint8_t data, const uint8_t value_mask)
+{
+	uint8_t value = data & value_mask;
+
+	_ds3231_bcd_to_hex(&value);
+
+	return value;
+}
+#endif
+
+#if DS3231_INCLUDE_BCD_SWAR
+/********************************************************/
+/********************************************************/
+uint64_t _ds3231_time_block_load(const uint8_t *data)
+{
+	uint64_t block = 0;
+
+	/*Byte by byte, so the packing does not depend on endianness or alignment*/
+	for (int index = DS3231_SECONDS; index <= DS3231_YEAR; index++)
+	{
+		block |= (uint64_t)data[index] << (8 * index);
+	}
+
+	return block;
+}
+
+/********************************************************/
+/********************************************************/
+void _ds3231_time_block_store(uint64_t block, uint8_t *data)
+{
+	for (int index = DS3231_SECONDS; index <= DS3231_YEAR; index++)
+	{
+		data[index] = (uint8_t)(block >> (8 * index));
+	}
+}
+
+/********************************************************/
+/********************************************************/
+uint64_t _ds3231_swar_hex_to_bcd(uint64_t lanes)
+{
+	/*Four 16 bit lanes. A lane of at most 255 times 103 never carries into the next lane*/
+	uint64_t tens = ((lanes * 103) >> 10) & 0X000F000F000F000FULL;
+
+	return lanes + tens * 6;
+}
+#endif
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_time_block_bcd_to_hex(uint8_t *data)
+{
+#if DS3231_INCLUDE_BCD_SWAR
+	uint64_t block = _ds3231_time_block_load(data) & DS3231_TIME_BLOCK_MASK;
+
+	/*Every byte holds two BCD digits, tens times 10 is at most 150 and never carries into the next byte*/
+	uint64_t tens = (block >> 4) & 0X000F0F0F0F0F0F0FULL;
+	uint64_t ones = block & 0X000F0F0F0F0F0F0FULL;
+
+	_ds3231_time_block_store(ones + (tens << 3) + (tens << 1), data);
+#else
+	for (int index = DS3231_SECONDS; index <= DS3231_YEAR; index++)
+	{
+		uint8_t masked = data[index] & DS3231_MASK_AND_RANGE_LUT[index].mask;
+
+		data[index] = DS3231_BCD_TENS_LUT[masked >> 4] + (masked & 0X0F);
+	}
+#endif
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_time_block_hex_to_bcd(uint8_t *data)
+{
+#if DS3231_INCLUDE_BCD_SWAR
+	uint64_t low_lanes = 0;
+	uint64_t high_lanes = 0;
+
+	/*Load the bytes straight into 16 bit lanes, to have room for the multiplication*/
+	for (int index = DS3231_SECONDS; index < DS3231_DAY; index++)
+	{
+		low_lanes |= (uint64_t)data[index] << (16 * index);
+	}
+	for (int index = DS3231_DAY; index <= DS3231_YEAR; index++)
+	{
+		high_lanes |= (uint64_t)data[index] << (16 * (index - DS3231_DAY));
+	}
+
+	low_lanes = _ds3231_swar_hex_to_bcd(low_lanes);
+	high_lanes = _ds3231_swar_hex_to_bcd(high_lanes);
+
+	/*Store the low byte of every lane, masked*/
+	for (int index = DS3231_SECONDS; index < DS3231_DAY; index++)
+	{
+		data[index] = (uint8_t)(low_lanes >> (16 * index)) & DS3231_MASK_AND_RANGE_LUT[index].mask;
+	}
+	for (int index = DS3231_DAY; index <= DS3231_YEAR; index++)
+	{
+		data[index] = (uint8_t)(high_lanes >> (16 * (index - DS3231_DAY))) & DS3231_MASK_AND_RANGE_LUT[index].mask;
+	}
+#else
+	for (int index = DS3231_SECONDS; index <= DS3231_YEAR; index++)
+	{
+		if (data[index] < 100)
+		{
+			data[index] = DS3231_HEX_TO_BCD_LUT[data[index]];
+		}
+
+		data[index] &= DS3231_MASK_AND_RANGE_LUT[index].mask;
+	}
+#endif
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_SAFE_RANGE_CHECK
+ds3231_error_code_t ds3231_validate_time_and_calendar(const ds3231_time_and_calendar_t *time_struct, ds3231_field_mask_t *failing_fields)
+{
+	uint32_t year = (uint32_t)time_struct->year;
+	uint32_t month = (uint32_t)time_struct->month;
+
+	/*Every check is an unsigned compare, values below the minimum wrap around and fail as well*/
+	uint32_t second_fail = ((uint32_t)time_struct->second - DS3231_RANGE_MINIMUM_SECOND) > (DS3231_RANGE_MAXIMUM_SECOND - DS3231_RANGE_MINIMUM_SECOND);
+	uint32_t minute_fail = ((uint32_t)time_struct->minute - DS3231_RANGE_MINIMUM_MINUTE) > (DS3231_RANGE_MAXIMUM_MINUTE - DS3231_RANGE_MINIMUM_MINUTE);
+	uint32_t hour_fail = ((uint32_t)time_struct->hour - DS3231_RANGE_MINIMUM_HOUR) > (DS3231_RANGE_MAXIMUM_HOUR - DS3231_RANGE_MINIMUM_HOUR);
+	uint32_t day_fail = ((uint32_t)time_struct->day - DS3231_RANGE_MINIMUM_DAY) > (DS3231_RANGE_MAXIMUM_DAY - DS3231_RANGE_MINIMUM_DAY);
+	uint32_t month_fail = (month - DS3231_RANGE_MINIMUM_MONTH) > (DS3231_RANGE_MAXIMUM_MONTH - DS3231_RANGE_MINIMUM_MONTH);
+	uint32_t year_fail = (year - DS3231_RANGE_MINIMUM_YEAR) > (DS3231_RANGE_MAXIMUM_YEAR - DS3231_RANGE_MINIMUM_YEAR);
+
+	/*Leap-year-aware last date of the month, without branches*/
+	uint32_t is_leap = ((year & 3) == 0) & (((year % 100) != 0) | ((year % 400) == 0));
+	uint32_t last_date = DS3231_DAYS_IN_MONTH_LUT[month & 0X0F] + (is_leap & (month == DS3231_MONTH_FEBRUARY));
+	uint32_t date_fail = ((uint32_t)time_struct->date - DS3231_RANGE_MINIMUM_DATE) > (last_date - DS3231_RANGE_MINIMUM_DATE);
+
+	*failing_fields = (ds3231_field_mask_t)(
+		(second_fail << DS3231_SECONDS) |
+		(minute_fail << DS3231_MINUTES) |
+		(hour_fail << DS3231_HOURS) |
+		(day_fail << DS3231_DAY) |
+		(date_fail << DS3231_DATE) |
+		(month_fail << DS3231_MONTH) |
+		(year_fail << DS3231_YEAR));
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_field_range_error(const ds3231_field_mask_t failing_fields)
+{
+	/*Report the first failing field, in register order*/
+	for (int index = DS3231_SECONDS; index <= DS3231_YEAR; index++)
+	{
+		if (failing_fields & (1 << index))
+		{
+			return DS3231_MASK_AND_RANGE_LUT[index].error;
+		}
+	}
+
+	return DS3231_ERROR_OK;
+}
+#endif
+
 /********************************************************/
 /********************************************************/
 #if DS3231_INCLUDE_NULL_CHECK
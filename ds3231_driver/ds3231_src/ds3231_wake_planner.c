@@ -0,0 +1,337 @@
+/**
+ * @file ds3231_wake_planner.c
+ * @brief DS3231 Real Time Clock C Driver
+ * @author Reza G. Ebrahimi <https://github.com/ebrezadev>
+ * @version 2.0
+ * @license MIT
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Reza G. Ebrahimi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "ds3231.h"
+#include "ds3231_macros.h"
+
+
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_WAKE_PLANNER
+void ds3231_wake_planner_init(ds3231_wake_planner_t *planner)
+{
+	planner->task_count = 0;
+	planner->use_heartbeat = DS3231_FALSE;
+	planner->programmed = DS3231_WAKE_NEVER;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_wake_planner_add(ds3231_wake_planner_t *planner, const ds3231_epoch_t deadline, const uint32_t tolerance, const uint32_t period, uint8_t *task_index)
+{
+	if (planner->task_count >= DS3231_WAKE_PLANNER_CAPACITY)
+	{
+		return DS3231_ERROR_WAKE_PLANNER_FULL;
+	}
+
+	ds3231_wake_task_t *task = &planner->tasks[planner->task_count];
+
+	task->deadline = deadline;
+	task->tolerance = tolerance;
+	task->period = period;
+
+	if (task_index != NULL)
+	{
+		*task_index = planner->task_count;
+	}
+	planner->task_count++;
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_wake_planner_next(const ds3231_wake_planner_t *planner, const ds3231_epoch_t now, ds3231_epoch_t *wake, ds3231_wake_source_t *source)
+{
+	*wake = _ds3231_wake_planner_alarm_1_wake(planner, now);
+	*source = DS3231_WAKE_BY_ALARM_1;
+
+	/*The heartbeat wakes up anyway, a deadline after it may still be served there*/
+	if (planner->use_heartbeat == DS3231_TRUE)
+	{
+		ds3231_epoch_t heartbeat;
+
+		ds3231_error_code_t error = ds3231_alarm_2_next_fire(&planner->heartbeat, now, &heartbeat);
+		DS3231_CHECK_AND_RETURN_ERROR(error);
+
+		if (heartbeat <= *wake)
+		{
+			*wake = heartbeat;
+			*source = DS3231_WAKE_BY_ALARM_2;
+		}
+	}
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_wake_planner_estimate(const ds3231_wake_planner_t *planner, const ds3231_epoch_t start, const uint32_t duration, ds3231_wake_estimate_t *estimate)
+{
+	ds3231_error_code_t error;
+	ds3231_wake_planner_t plan = *planner;
+	ds3231_epoch_t now = start;
+	ds3231_epoch_t end = start + duration;
+	ds3231_epoch_t wake;
+	ds3231_wake_source_t source;
+
+	estimate->wakes = 0;
+	estimate->alarm_1_wakes = 0;
+	estimate->alarm_2_wakes = 0;
+	estimate->task_runs = 0;
+	estimate->bus_bytes = 0;
+
+	/*As after ds3231_wake_planner_start, the start itself is not counted*/
+	plan.programmed = _ds3231_wake_planner_alarm_1_wake(&plan, now);
+
+	while (1)
+	{
+		error = ds3231_wake_planner_next(&plan, now, &wake, &source);
+		DS3231_CHECK_AND_RETURN_ERROR(error);
+
+		if (wake > end)
+		{
+			break;
+		}
+
+		now = wake;
+		estimate->wakes++;
+		if (source == DS3231_WAKE_BY_ALARM_1)
+		{
+			estimate->alarm_1_wakes++;
+		}
+		else
+		{
+			estimate->alarm_2_wakes++;
+		}
+
+		for (uint32_t due = _ds3231_wake_planner_collect(&plan, now); due != 0; due &= due - 1)
+		{
+			estimate->task_runs++;
+		}
+
+		/*The same transactions as ds3231_wake_planner_service, alarm 1 is only written when it changes*/
+		ds3231_epoch_t alarm_1_wake = _ds3231_wake_planner_alarm_1_wake(&plan, now);
+		estimate->bus_bytes += DS3231_I2C_READ_OVERHEAD_BYTES + DS3231_NUMBER_OF_REGISTERS_TO_STATUS + DS3231_I2C_WRITE_OVERHEAD_BYTES;
+		estimate->bus_bytes += (alarm_1_wake != plan.programmed) ? DS3231_ALARM_1_WRITE_LENGTH : 1;
+		plan.programmed = alarm_1_wake;
+	}
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_wake_planner_start(const ds3231_handle_t *handle, ds3231_wake_planner_t *planner)
+{
+	uint32_t due;
+
+	return _ds3231_wake_planner_arm(handle, planner, DS3231_TRUE, &due);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_wake_planner_service(const ds3231_handle_t *handle, ds3231_wake_planner_t *planner, uint32_t *due)
+{
+	return _ds3231_wake_planner_arm(handle, planner, DS3231_FALSE, due);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_wake_planner_arm(const ds3231_handle_t *handle, ds3231_wake_planner_t *planner, const ds3231_bool_t start, uint32_t *due)
+{
+#if DS3231_INCLUDE_WRITE_VERIFICATION | DS3231_INCLUDE_NULL_CHECK
+	ds3231_error_code_t error;
+#endif
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t data[DS3231_NUMBER_OF_REGISTERS_TO_STATUS];
+	uint8_t flags = (uint8_t)((1 << DS3231_BIT_A1F) | (1 << DS3231_BIT_A2F));
+
+	*due = 0;
+
+	/*The lock is held from the read to the write, so the control and status registers written back are not stale*/
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_SECONDS, data, DS3231_NUMBER_OF_REGISTERS_TO_STATUS) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+
+	ds3231_epoch_t now = _ds3231_epoch_from_time_block(data);
+	if (start == DS3231_FALSE)
+	{
+		*due = _ds3231_wake_planner_collect(planner, now);
+	}
+
+	ds3231_epoch_t alarm_1_wake = _ds3231_wake_planner_alarm_1_wake(planner, now);
+	ds3231_bool_t rewrite = (ds3231_bool_t)((start == DS3231_TRUE) || (alarm_1_wake != planner->programmed));
+
+	if (start == DS3231_TRUE)
+	{
+		if (planner->use_heartbeat == DS3231_TRUE)
+		{
+			_ds3231_alarm_2_encode(&planner->heartbeat, &data[DS3231_REGISTER_ALARM2_MINUTES]);
+			data[DS3231_REGISTER_CONTROL] |= (uint8_t)(1 << DS3231_BIT_A2IE);
+		}
+		else
+		{
+			data[DS3231_REGISTER_CONTROL] &= (uint8_t)(~(1 << DS3231_BIT_A2IE));
+		}
+
+		/*Stale flags from before the start are cleared*/
+		data[DS3231_REGISTER_CONTROL_STATUS] |= flags;
+	}
+
+	if (rewrite == DS3231_TRUE)
+	{
+		if (alarm_1_wake == DS3231_WAKE_NEVER)
+		{
+			data[DS3231_REGISTER_CONTROL] &= (uint8_t)(~(1 << DS3231_BIT_A1IE));
+		}
+		else
+		{
+			ds3231_time_and_calendar_t time_struct;
+			ds3231_alarm_1_config_t config;
+
+			/*Within DS3231_WAKE_MAX_SLEEP_S the date match fires first at the wake up*/
+			ds3231_epoch_to_time_and_calendar(alarm_1_wake, &time_struct);
+			config.second = time_struct.second;
+			config.minute = time_struct.minute;
+			config.hour = time_struct.hour;
+			config.day_date.date = time_struct.date;
+			config.day_date_type = DS3231_ALARM_DATE;
+			config.alarm_rate = DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR_DATE;
+			_ds3231_alarm_1_encode(&config, &data[DS3231_REGISTER_ALARM1_SECONDS]);
+			data[DS3231_REGISTER_CONTROL] |= (uint8_t)(1 << DS3231_BIT_A1IE);
+		}
+	}
+
+	/*CONV is not restarted. The flags can only be cleared, the ones read set are cleared and the others written as 1 to not lose a fire since the read*/
+	data[DS3231_REGISTER_CONTROL] &= (uint8_t)(~(1 << DS3231_BIT_CONV));
+	data[DS3231_REGISTER_CONTROL_STATUS] ^= flags;
+
+	if (rewrite == DS3231_TRUE)
+	{
+		if (handle->interface.write_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM1_SECONDS, &data[DS3231_REGISTER_ALARM1_SECONDS], DS3231_ALARM_1_WRITE_LENGTH) != 0)
+		{
+			DS3231_UNLOCK(handle);
+			return DS3231_ERROR_INTERFACE_WRITE;
+		}
+	}
+	else
+	{
+		if (handle->interface.write_array((uint8_t)handle->i2c_address, DS3231_REGISTER_CONTROL_STATUS, &data[DS3231_REGISTER_CONTROL_STATUS], 1) != 0)
+		{
+			DS3231_UNLOCK(handle);
+			return DS3231_ERROR_INTERFACE_WRITE;
+		}
+	}
+	DS3231_UNLOCK(handle);
+
+	planner->programmed = alarm_1_wake;
+
+	if (rewrite == DS3231_TRUE)
+	{
+		DS3231_VERIFY_BYTES(handle, error, DS3231_REGISTER_ALARM1_SECONDS, &data[DS3231_REGISTER_ALARM1_SECONDS], DS3231_NUMBER_OF_ALARM_1_REGISTERS + DS3231_NUMBER_OF_ALARM_2_REGISTERS);
+	}
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+uint32_t _ds3231_wake_planner_collect(ds3231_wake_planner_t *planner, const ds3231_epoch_t now)
+{
+	uint32_t due = 0;
+
+	for (uint8_t index = 0; index < planner->task_count; index++)
+	{
+		ds3231_wake_task_t *task = &planner->tasks[index];
+
+		if ((task->deadline == DS3231_WAKE_NEVER) || ((task->deadline - task->tolerance) > now))
+		{
+			continue;
+		}
+
+		due |= (uint32_t)1 << index;
+
+		/*A run serves one window, the deadlines missed meanwhile are skipped*/
+		if (task->period == 0)
+		{
+			task->deadline = DS3231_WAKE_NEVER;
+		}
+		else if (task->deadline <= now)
+		{
+			task->deadline += ((now - task->deadline) / task->period + 1) * task->period;
+		}
+		else
+		{
+			task->deadline += task->period;
+		}
+	}
+
+	return due;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_epoch_t _ds3231_wake_planner_alarm_1_wake(const ds3231_wake_planner_t *planner, const ds3231_epoch_t now)
+{
+	ds3231_epoch_t wake = DS3231_WAKE_NEVER;
+
+	for (uint8_t index = 0; index < planner->task_count; index++)
+	{
+		if (planner->tasks[index].deadline < wake)
+		{
+			wake = planner->tasks[index].deadline;
+		}
+	}
+
+	if (wake == DS3231_WAKE_NEVER)
+	{
+		return DS3231_WAKE_NEVER;
+	}
+
+	/*A deadline too close is served a little late, one too far is reached with a wake up in between*/
+	if (wake < now + DS3231_WAKE_MIN_LEAD_S)
+	{
+		wake = now + DS3231_WAKE_MIN_LEAD_S;
+	}
+	else if (wake > now + DS3231_WAKE_MAX_SLEEP_S)
+	{
+		wake = now + DS3231_WAKE_MAX_SLEEP_S;
+	}
+
+	return wake;
+}
+
+#endif
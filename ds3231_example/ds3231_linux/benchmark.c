@@ -0,0 +1,454 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ds3231.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCHMARK_HAS_CYCLES 1
+#else
+#define BENCHMARK_HAS_CYCLES 0
+#endif
+
+/*The inputs are cycled through, so the branch predictor can not learn them*/
+#define BENCHMARK_NUMBER_OF_BLOCKS 256
+#define BENCHMARK_ITERATIONS 10000000UL
+/*The best of a few runs, to leave out the interruptions*/
+#define BENCHMARK_RUNS 5
+/*The seconds to year registers*/
+#define BENCHMARK_BLOCK_LENGTH 7
+
+static uint8_t hex_blocks[BENCHMARK_NUMBER_OF_BLOCKS][BENCHMARK_BLOCK_LENGTH];
+static uint8_t bcd_blocks[BENCHMARK_NUMBER_OF_BLOCKS][BENCHMARK_BLOCK_LENGTH];
+/*All valid, and one in four with a random field out of range or an impossible date*/
+static ds3231_time_and_calendar_t valid_structs[BENCHMARK_NUMBER_OF_BLOCKS];
+static ds3231_time_and_calendar_t mixed_structs[BENCHMARK_NUMBER_OF_BLOCKS];
+
+/*The policy section runs the driver against an in-memory DS3231 that only counts the I2C traffic*/
+#define BENCHMARK_POLICY_CALLS 1000000UL
+#define BENCHMARK_NUMBER_OF_REGISTERS 19
+/*At 400 kHz, 9 clocks per byte with the ACK, and about 2 bytes worth for the start, the restart and the stop*/
+#define BENCHMARK_I2C_NS_PER_BYTE 22500
+#define BENCHMARK_I2C_NS_PER_TRANSACTION 45000
+
+static uint8_t stub_registers[BENCHMARK_NUMBER_OF_REGISTERS] = {0X30, 0X15, 0X12, 0X07, 0X15, 0X06, 0X25};
+static unsigned long stub_transactions;
+static unsigned long stub_bytes;
+
+/*Keeps the results alive*/
+static volatile uint8_t benchmark_sink;
+
+typedef void (*benchmark_kernel_t)(uint8_t *data);
+
+typedef uint8_t (*benchmark_validator_t)(const ds3231_time_and_calendar_t *time_struct);
+
+typedef struct
+{
+	double ns;
+	double cycles;
+} benchmark_result_t;
+
+static int64_t benchmark_clock_ns(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (int64_t)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+static void kernel_copy_only(uint8_t *data)
+{
+	(void)data;
+}
+
+static void kernel_block_bcd_to_hex(uint8_t *data)
+{
+	_ds3231_time_block_bcd_to_hex(data);
+}
+
+static void kernel_block_hex_to_bcd(uint8_t *data)
+{
+	_ds3231_time_block_hex_to_bcd(data);
+}
+
+/*The single byte helpers, as the driver used them before the block conversion*/
+static void kernel_bytes_bcd_to_hex(uint8_t *data)
+{
+	for (int index = DS3231_SECONDS; index <= DS3231_YEAR; index++)
+	{
+		data[index] &= DS3231_MASK_AND_RANGE_LUT[index].mask;
+		_ds3231_bcd_to_hex(&data[index]);
+	}
+}
+
+static void kernel_bytes_hex_to_bcd(uint8_t *data)
+{
+	for (int index = DS3231_SECONDS; index <= DS3231_YEAR; index++)
+	{
+		_ds3231_hex_to_bcd(&data[index]);
+		data[index] &= DS3231_MASK_AND_RANGE_LUT[index].mask;
+	}
+}
+
+/*The block and the byte by byte conversions must agree before they are timed*/
+static int benchmark_check(void)
+{
+	for (int block = 0; block < BENCHMARK_NUMBER_OF_BLOCKS; block++)
+	{
+		uint8_t by_block[BENCHMARK_BLOCK_LENGTH];
+		uint8_t by_bytes[BENCHMARK_BLOCK_LENGTH];
+
+		memcpy(by_block, bcd_blocks[block], sizeof(by_block));
+		memcpy(by_bytes, bcd_blocks[block], sizeof(by_bytes));
+		kernel_block_bcd_to_hex(by_block);
+		kernel_bytes_bcd_to_hex(by_bytes);
+		if ((memcmp(by_block, by_bytes, sizeof(by_block)) != 0) || (memcmp(by_block, hex_blocks[block], sizeof(by_block)) != 0))
+		{
+			return 1;
+		}
+
+		kernel_block_hex_to_bcd(by_block);
+		kernel_bytes_hex_to_bcd(by_bytes);
+		if ((memcmp(by_block, by_bytes, sizeof(by_block)) != 0) || (memcmp(by_block, bcd_blocks[block], sizeof(by_block)) != 0))
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static benchmark_result_t benchmark_run(benchmark_kernel_t kernel, uint8_t blocks[][BENCHMARK_BLOCK_LENGTH])
+{
+	benchmark_result_t result = {0, 0};
+	uint8_t data[BENCHMARK_BLOCK_LENGTH];
+	uint8_t sink = 0;
+
+	int64_t start_ns = benchmark_clock_ns();
+#if BENCHMARK_HAS_CYCLES
+	uint64_t start_cycles = __rdtsc();
+#endif
+
+	for (unsigned long iteration = 0; iteration < BENCHMARK_ITERATIONS; iteration++)
+	{
+		memcpy(data, blocks[iteration % BENCHMARK_NUMBER_OF_BLOCKS], sizeof(data));
+		kernel(data);
+		sink ^= data[DS3231_SECONDS] ^ data[DS3231_YEAR];
+	}
+
+#if BENCHMARK_HAS_CYCLES
+	result.cycles = (double)(__rdtsc() - start_cycles) / BENCHMARK_ITERATIONS;
+#endif
+	result.ns = (double)(benchmark_clock_ns() - start_ns) / BENCHMARK_ITERATIONS;
+	benchmark_sink = sink;
+
+	return result;
+}
+
+static benchmark_result_t benchmark_best(benchmark_kernel_t kernel, uint8_t blocks[][BENCHMARK_BLOCK_LENGTH])
+{
+	benchmark_result_t best = benchmark_run(kernel, blocks);
+
+	for (int run = 1; run < BENCHMARK_RUNS; run++)
+	{
+		benchmark_result_t result = benchmark_run(kernel, blocks);
+
+		if (result.ns < best.ns)
+		{
+			best = result;
+		}
+	}
+
+	return best;
+}
+
+static void benchmark_print(const char *name, benchmark_kernel_t kernel, uint8_t blocks[][BENCHMARK_BLOCK_LENGTH], benchmark_result_t overhead)
+{
+	benchmark_result_t result = benchmark_best(kernel, blocks);
+
+	/*The loop and copy overhead is measured separately and left out*/
+	printf("  %-24s %6.2f ns", name, result.ns - overhead.ns);
+#if BENCHMARK_HAS_CYCLES
+	printf(" %6.1f TSC cycles", result.cycles - overhead.cycles);
+#endif
+	printf(" per 7 byte block\n");
+}
+
+static uint8_t validator_none(const ds3231_time_and_calendar_t *time_struct)
+{
+	(void)time_struct;
+
+	return 0;
+}
+
+static uint8_t validator_branch_free(const ds3231_time_and_calendar_t *time_struct)
+{
+	ds3231_field_mask_t failing_fields;
+
+	ds3231_validate_time_and_calendar(time_struct, &failing_fields);
+
+	return failing_fields;
+}
+
+/*The field by field check with early returns the driver used before, it misses the impossible dates*/
+static uint8_t validator_field_by_field(const ds3231_time_and_calendar_t *time_struct)
+{
+	const uint16_t fields[BENCHMARK_BLOCK_LENGTH] = {time_struct->second, time_struct->minute, time_struct->hour, (uint16_t)time_struct->day,
+													 time_struct->date, (uint16_t)time_struct->month, time_struct->year};
+
+	for (int index = DS3231_SECONDS; index <= DS3231_YEAR; index++)
+	{
+		if ((fields[index] < DS3231_MASK_AND_RANGE_LUT[index].range_min) || (fields[index] > DS3231_MASK_AND_RANGE_LUT[index].range_max))
+		{
+			return (uint8_t)(1 << index);
+		}
+	}
+
+	return 0;
+}
+
+static benchmark_result_t benchmark_validation_run(benchmark_validator_t validator, const ds3231_time_and_calendar_t *structs)
+{
+	benchmark_result_t best = {0, 0};
+
+	for (int run = 0; run < BENCHMARK_RUNS; run++)
+	{
+		benchmark_result_t result = {0, 0};
+		uint8_t sink = 0;
+
+		int64_t start_ns = benchmark_clock_ns();
+#if BENCHMARK_HAS_CYCLES
+		uint64_t start_cycles = __rdtsc();
+#endif
+
+		for (unsigned long iteration = 0; iteration < BENCHMARK_ITERATIONS; iteration++)
+		{
+			sink ^= validator(&structs[iteration % BENCHMARK_NUMBER_OF_BLOCKS]);
+		}
+
+#if BENCHMARK_HAS_CYCLES
+		result.cycles = (double)(__rdtsc() - start_cycles) / BENCHMARK_ITERATIONS;
+#endif
+		result.ns = (double)(benchmark_clock_ns() - start_ns) / BENCHMARK_ITERATIONS;
+		benchmark_sink = sink;
+
+		if ((run == 0) || (result.ns < best.ns))
+		{
+			best = result;
+		}
+	}
+
+	return best;
+}
+
+static void benchmark_validation_print(const char *name, benchmark_validator_t validator, const ds3231_time_and_calendar_t *structs, benchmark_result_t overhead)
+{
+	benchmark_result_t result = benchmark_validation_run(validator, structs);
+
+	printf("  %-32s %6.2f ns", name, result.ns - overhead.ns);
+#if BENCHMARK_HAS_CYCLES
+	printf(" %6.1f TSC cycles", result.cycles - overhead.cycles);
+#endif
+	printf(" per struct, %5.1f M structs/s\n", 1000.0 / (result.ns - overhead.ns));
+}
+
+static int stub_interface_init(uint8_t deviceAddress)
+{
+	(void)deviceAddress;
+
+	return 0;
+}
+
+static int stub_interface_deinit(uint8_t deviceAddress)
+{
+	(void)deviceAddress;
+
+	return 0;
+}
+
+static int stub_delay_function(uint32_t delayMS)
+{
+	(void)delayMS;
+
+	return 0;
+}
+
+/*The address and the register, then the data*/
+static int stub_write_array(uint8_t deviceAddress, uint8_t startRegisterAddress, uint8_t *data, uint8_t dataLength)
+{
+	(void)deviceAddress;
+	memcpy(&stub_registers[startRegisterAddress], data, dataLength);
+	stub_transactions++;
+	stub_bytes += 2 + dataLength;
+
+	return 0;
+}
+
+/*The address and the register, the address again after the restart, then the data*/
+static int stub_read_array(uint8_t deviceAddress, uint8_t startRegisterAddress, uint8_t *data, uint8_t dataLength)
+{
+	(void)deviceAddress;
+	memcpy(data, &stub_registers[startRegisterAddress], dataLength);
+	stub_transactions++;
+	stub_bytes += 3 + dataLength;
+
+	return 0;
+}
+
+/*The address only*/
+static int stub_interface_ack_test(uint8_t deviceAddress)
+{
+	(void)deviceAddress;
+	stub_transactions++;
+	stub_bytes += 1;
+
+	return 0;
+}
+
+static void benchmark_policy_print(const char *name, ds3231_handle_t *handle, ds3231_policy_t policy, int write)
+{
+	const ds3231_time_and_calendar_t time_to_set = {30, 15, 12, DS3231_DAY_SUNDAY, 15, DS3231_MONTH_JUNE, 2025};
+	ds3231_time_and_calendar_t time_struct;
+	double best_ns = 0;
+
+	handle->policy = policy;
+
+	for (int run = 0; run < BENCHMARK_RUNS; run++)
+	{
+		stub_transactions = 0;
+		stub_bytes = 0;
+
+		int64_t start_ns = benchmark_clock_ns();
+		for (unsigned long call = 0; call < BENCHMARK_POLICY_CALLS; call++)
+		{
+			if (write)
+			{
+				/*The set function trims the year in place*/
+				time_struct = time_to_set;
+				ds3231_set_all_time_and_calendar(handle, &time_struct);
+			}
+			else
+			{
+				ds3231_get_all_time_and_calendar(handle, &time_struct);
+			}
+		}
+		double ns = (double)(benchmark_clock_ns() - start_ns) / BENCHMARK_POLICY_CALLS;
+
+		if ((run == 0) || (ns < best_ns))
+		{
+			best_ns = ns;
+		}
+	}
+
+	double transactions = (double)stub_transactions / BENCHMARK_POLICY_CALLS;
+	double bytes = (double)stub_bytes / BENCHMARK_POLICY_CALLS;
+	double bus_us = (transactions * BENCHMARK_I2C_NS_PER_TRANSACTION + bytes * BENCHMARK_I2C_NS_PER_BYTE) / 1000.0;
+
+	printf("  %-10s %3.0f transactions %4.0f bytes, %6.1f us on the bus, %6.2f ns CPU per call\n", name, transactions, bytes, bus_us, best_ns);
+}
+
+static void benchmark_setup(void)
+{
+	srand(1);
+	for (int block = 0; block < BENCHMARK_NUMBER_OF_BLOCKS; block++)
+	{
+		hex_blocks[block][DS3231_SECONDS] = (uint8_t)(rand() % 60);
+		hex_blocks[block][DS3231_MINUTES] = (uint8_t)(rand() % 60);
+		hex_blocks[block][DS3231_HOURS] = (uint8_t)(rand() % 24);
+		hex_blocks[block][DS3231_DAY] = (uint8_t)(1 + rand() % 7);
+		hex_blocks[block][DS3231_DATE] = (uint8_t)(1 + rand() % 28);
+		hex_blocks[block][DS3231_MONTH] = (uint8_t)(1 + rand() % 12);
+		hex_blocks[block][DS3231_YEAR] = (uint8_t)(rand() % 100);
+
+		for (int index = DS3231_SECONDS; index <= DS3231_YEAR; index++)
+		{
+			bcd_blocks[block][index] = (uint8_t)(((hex_blocks[block][index] / 10) << 4) | (hex_blocks[block][index] % 10));
+		}
+
+		ds3231_time_and_calendar_t *time_struct = &valid_structs[block];
+		time_struct->second = hex_blocks[block][DS3231_SECONDS];
+		time_struct->minute = hex_blocks[block][DS3231_MINUTES];
+		time_struct->hour = hex_blocks[block][DS3231_HOURS];
+		time_struct->day = (ds3231_day_t)hex_blocks[block][DS3231_DAY];
+		time_struct->date = hex_blocks[block][DS3231_DATE];
+		time_struct->month = (ds3231_month_t)hex_blocks[block][DS3231_MONTH];
+		time_struct->year = (uint16_t)(2000 + hex_blocks[block][DS3231_YEAR]);
+
+		mixed_structs[block] = valid_structs[block];
+		if ((rand() % 4) == 0)
+		{
+			time_struct = &mixed_structs[block];
+			switch (rand() % 4)
+			{
+			case 0:
+				time_struct->second = 60;
+				break;
+			case 1:
+				time_struct->hour = 24;
+				break;
+			case 2:
+				/*February 30 passes the field by field check*/
+				time_struct->month = DS3231_MONTH_FEBRUARY;
+				time_struct->date = 30;
+				break;
+			default:
+				time_struct->year = 2100;
+				break;
+			}
+		}
+	}
+}
+
+int main(void)
+{
+	benchmark_setup();
+
+	if (benchmark_check() != 0)
+	{
+		fprintf(stderr, "BCD CONVERSION MISMATCH\n");
+		return 1;
+	}
+
+	printf("BCD CONVERSION, %s PATH (DS3231_INCLUDE_BCD_SWAR %d)\n", DS3231_INCLUDE_BCD_SWAR ? "SWAR" : "LOOKUP TABLE", DS3231_INCLUDE_BCD_SWAR);
+
+	benchmark_result_t overhead = benchmark_best(kernel_copy_only, bcd_blocks);
+
+	benchmark_print("block BCD to HEX", kernel_block_bcd_to_hex, bcd_blocks, overhead);
+	benchmark_print("byte by byte BCD to HEX", kernel_bytes_bcd_to_hex, bcd_blocks, overhead);
+	benchmark_print("block HEX to BCD", kernel_block_hex_to_bcd, hex_blocks, overhead);
+	benchmark_print("byte by byte HEX to BCD", kernel_bytes_hex_to_bcd, hex_blocks, overhead);
+
+	printf("TIME AND CALENDAR VALIDATION\n");
+
+	overhead = benchmark_validation_run(validator_none, valid_structs);
+
+	benchmark_validation_print("branch-free, all valid", validator_branch_free, valid_structs, overhead);
+	benchmark_validation_print("field by field, all valid", validator_field_by_field, valid_structs, overhead);
+	benchmark_validation_print("branch-free, 1 in 4 invalid", validator_branch_free, mixed_structs, overhead);
+	benchmark_validation_print("field by field, 1 in 4 invalid", validator_field_by_field, mixed_structs, overhead);
+
+	ds3231_handle_t handle;
+
+	memset(&handle, 0, sizeof(handle));
+	handle.interface.interface_init = stub_interface_init;
+	handle.interface.interface_deinit = stub_interface_deinit;
+	handle.interface.delay_function = stub_delay_function;
+	handle.interface.read_array = stub_read_array;
+	handle.interface.write_array = stub_write_array;
+	handle.interface.interface_ack_test = stub_interface_ack_test;
+	ds3231_error_code_t error = ds3231_init(&handle);
+	if (error != DS3231_ERROR_OK)
+	{
+		fprintf(stderr, "INIT ERR: %d\n", error);
+		return 1;
+	}
+
+	printf("RUNTIME POLICY, THE BUS TIME AT 400 KHZ\n");
+	benchmark_policy_print("read safe", &handle, DS3231_POLICY_SAFE, 0);
+	benchmark_policy_print("read lean", &handle, DS3231_POLICY_LEAN, 0);
+	benchmark_policy_print("write safe", &handle, DS3231_POLICY_SAFE, 1);
+	benchmark_policy_print("write lean", &handle, DS3231_POLICY_LEAN, 1);
+
+	return 0;
+}
@@ -98,7 +98,51 @@ extern "C"
 		/*error in temperature read busy bit timeout*/
 		DS3231_ERROR_TEMPERATURE_BUSY_TIMEOUT,
 		/*error in temperature read conversion timeout*/
-		DS3231_ERROR_TEMPERATURE_CONVERSION_TIMEOUT
+		DS3231_ERROR_TEMPERATURE_CONVERSION_TIMEOUT,
+#endif
+#if DS3231_INCLUDE_DRIFT_ESTIMATION
+		/*error in waiting for a seconds edge*/
+		DS3231_ERROR_DRIFT_EDGE_TIMEOUT,
+		/*error in drift estimation, not enough samples far enough apart*/
+		DS3231_ERROR_DRIFT_NOT_ENOUGH_SAMPLES,
+#endif
+#if DS3231_INCLUDE_TIME_SYNC
+		/*error in waiting for a seconds edge*/
+		DS3231_ERROR_SYNC_EDGE_TIMEOUT,
+		/*error in phase measurement, the time changed meanwhile*/
+		DS3231_ERROR_SYNC_INCONSISTENT,
+#endif
+#if DS3231_INCLUDE_TIMER_SERVICE
+		/*error in starting a timer, DS3231_TIMER_SERVICE_CAPACITY timers are already started*/
+		DS3231_ERROR_TIMER_SERVICE_FULL,
+#endif
+#if (DS3231_INCLUDE_ALARM_1 | DS3231_INCLUDE_ALARM_2) & DS3231_INCLUDE_CALENDAR
+		/*error in next fire computation, the alarm never matches*/
+		DS3231_ERROR_ALARM_NEVER_MATCHES,
+#endif
+#if DS3231_INCLUDE_CRON_ALARM
+		/*error in cron expression syntax or field range*/
+		DS3231_ERROR_CRON_SYNTAX,
+#endif
+#if DS3231_INCLUDE_ALARM_1 & DS3231_INCLUDE_CALENDAR
+		/*error in programming an alarm for an epoch, it is not after now or alarm 1 can't match it first*/
+		DS3231_ERROR_ALARM_OUT_OF_REACH,
+#endif
+#if DS3231_INCLUDE_WAKE_PLANNER
+		/*error in adding a task, DS3231_WAKE_PLANNER_CAPACITY tasks are already added*/
+		DS3231_ERROR_WAKE_PLANNER_FULL,
+#endif
+#if DS3231_INCLUDE_ALARM_1 | DS3231_INCLUDE_ALARM_2
+		/*error in reading back an alarm config, the mask bits are not those of a rate*/
+		DS3231_ERROR_ALARM_INVALID_MASK,
+#endif
+#if DS3231_INCLUDE_DEVICE_CONFIG
+		/*error in restoring a config blob, its CRC doesn't match*/
+		DS3231_ERROR_CONFIG_BLOB_CRC,
+#endif
+#if DS3231_INCLUDE_SAMPLE_STORE
+		/*error in iterating a sample store, it is empty or the cursor is past the end*/
+		DS3231_ERROR_SAMPLE_STORE_END,
 #endif
 	} ds3231_error_code_t;
 
@@ -142,7 +186,39 @@ extern "C"
 #endif
 #if DS3231_INCLUDE_TEMPERATURE
 		"TEMPERATURE BUSY TIMEOUT",
-		"TEMPERATURE CONVERSION TIMEOUT"
+		"TEMPERATURE CONVERSION TIMEOUT",
+#endif
+#if DS3231_INCLUDE_DRIFT_ESTIMATION
+		"DRIFT EDGE TIMEOUT",
+		"DRIFT NOT ENOUGH SAMPLES",
+#endif
+#if DS3231_INCLUDE_TIME_SYNC
+		"SYNC EDGE TIMEOUT",
+		"SYNC INCONSISTENT",
+#endif
+#if DS3231_INCLUDE_TIMER_SERVICE
+		"TIMER SERVICE FULL",
+#endif
+#if (DS3231_INCLUDE_ALARM_1 | DS3231_INCLUDE_ALARM_2) & DS3231_INCLUDE_CALENDAR
+		"ALARM NEVER MATCHES",
+#endif
+#if DS3231_INCLUDE_CRON_ALARM
+		"CRON SYNTAX",
+#endif
+#if DS3231_INCLUDE_ALARM_1 & DS3231_INCLUDE_CALENDAR
+		"ALARM OUT OF REACH",
+#endif
+#if DS3231_INCLUDE_WAKE_PLANNER
+		"WAKE PLANNER FULL",
+#endif
+#if DS3231_INCLUDE_ALARM_1 | DS3231_INCLUDE_ALARM_2
+		"ALARM INVALID MASK",
+#endif
+#if DS3231_INCLUDE_DEVICE_CONFIG
+		"CONFIG BLOB CRC",
+#endif
+#if DS3231_INCLUDE_SAMPLE_STORE
+		"SAMPLE STORE END",
 #endif
 	};
 #endif
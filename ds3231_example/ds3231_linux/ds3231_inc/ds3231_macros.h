@@ -48,37 +48,53 @@ extern "C"
 		}                                    \
 	} while (0)
 
+#if DS3231_INCLUDE_RUNTIME_POLICY
+/*Check whether the runtime policy of the handle keeps a compiled in check*/
+#define DS3231_POLICY_ENABLED(handle, skip_bit) (((handle)->policy & (skip_bit)) == 0)
+#else
+#define DS3231_POLICY_ENABLED(handle, skip_bit) 1
+#endif
 
 #if DS3231_INCLUDE_SAFE_RANGE_CHECK
 /*Check the value range for safety*/
-#define DS3231_RANGE_ERROR(value, index)                                                                                  \
-	do                                                                                                                    \
-	{                                                                                                                     \
-		if ((value < DS3231_MASK_AND_RANGE_LUT[index].range_min) || (value > DS3231_MASK_AND_RANGE_LUT[index].range_max)) \
-		{                                                                                                                 \
-			return DS3231_MASK_AND_RANGE_LUT[index].error;                                                                \
-		}                                                                                                                 \
+#define DS3231_RANGE_ERROR(handle, value, index)                                                                                                      \
+	do                                                                                                                                                \
+	{                                                                                                                                                 \
+		if (DS3231_POLICY_ENABLED(handle, DS3231_POLICY_SKIP_RANGE_CHECK) &&                                                                          \
+			((value < DS3231_MASK_AND_RANGE_LUT[index].range_min) || (value > DS3231_MASK_AND_RANGE_LUT[index].range_max)))                           \
+		{                                                                                                                                             \
+			return DS3231_MASK_AND_RANGE_LUT[index].error;                                                                                            \
+		}                                                                                                                                             \
 	} while (0)
-#else
-#define DS3231_RANGE_ERROR(value, index) ;
-#endif
-
-
-#if DS3231_INCLUDE_CONNECTION_CHECK
-/*Check the ds3231 connected to i2c bus*/
-#define DS3231_CONNECTION_CHECK(handle)                                         \
-	do                                                                                 \
-	{                                                                                  \
-		if (handle->interface.interface_ack_test((uint8_t)(handle->i2c_address)) != 0) \
-		{                                                                              \
-			return DS3231_ERROR_DS3231_NOT_CONNECTED;                                  \
-		}                                                                              \
+/*Check the value range in the functions that don't take a handle, regardless of the policy*/
+#define DS3231_VALUE_RANGE_ERROR(value, index)                                                                                        \
+	do                                                                                                                                \
+	{                                                                                                                                 \
+		if ((value < DS3231_MASK_AND_RANGE_LUT[index].range_min) || (value > DS3231_MASK_AND_RANGE_LUT[index].range_max))             \
+		{                                                                                                                             \
+			return DS3231_MASK_AND_RANGE_LUT[index].error;                                                                            \
+		}                                                                                                                             \
+	} while (0)
+/*Check all the fields of a time struct in one pass, return the error of the first failing field*/
+#define DS3231_TIME_STRUCT_RANGE_ERROR(handle, time_struct)                      \
+	do                                                                           \
+	{                                                                            \
+		if (DS3231_POLICY_ENABLED(handle, DS3231_POLICY_SKIP_RANGE_CHECK))       \
+		{                                                                        \
+			ds3231_field_mask_t failing_fields;                                  \
+			ds3231_validate_time_and_calendar((time_struct), &failing_fields);   \
+			if (failing_fields != 0)                                             \
+			{                                                                    \
+				return _ds3231_field_range_error(failing_fields);                \
+			}                                                                    \
+		}                                                                        \
 	} while (0)
 #else
-#define DS3231_CONNECTION_CHECK(handle) ;
+#define DS3231_RANGE_ERROR(handle, value, index) ;
+#define DS3231_VALUE_RANGE_ERROR(value, index) ;
+#define DS3231_TIME_STRUCT_RANGE_ERROR(handle, time_struct) ;
 #endif
 
-
 #if DS3231_INCLUDE_EXCLUSION_HOOK
 /*Defining mutual exclusion lock and unlock*/
 #define DS3231_LOCK(handle)                                                                                                        \
@@ -102,33 +118,57 @@ extern "C"
 #define DS3231_UNLOCK(handle) ;
 #endif
 
+#if DS3231_INCLUDE_CONNECTION_CHECK
+/*Check the ds3231 connected to i2c bus*/
+#define DS3231_CONNECTION_CHECK(handle)                                                \
+	do                                                                                     \
+	{                                                                                      \
+		if (DS3231_POLICY_ENABLED(handle, DS3231_POLICY_SKIP_CONNECTION_CHECK))            \
+		{                                                                                  \
+			DS3231_LOCK(handle);                                                           \
+			if (handle->interface.interface_ack_test((uint8_t)(handle->i2c_address)) != 0) \
+			{                                                                              \
+				DS3231_UNLOCK(handle);                                                     \
+				return DS3231_ERROR_DS3231_NOT_CONNECTED;                                  \
+			}                                                                              \
+			DS3231_UNLOCK(handle);                                                         \
+		}                                                                                  \
+	} while (0)
+#else
+#define DS3231_CONNECTION_CHECK(handle) ;
+#endif
 
 #if DS3231_INCLUDE_NULL_CHECK
 /*Checking for NULL pointers*/
 #define DS3231_NULL_CHECK_MACRO(handle, error) \
 	do                                         \
 	{                                          \
-		error = _ds3231_null_check(handle);     \
+		error = _ds3231_null_check(handle);    \
 		DS3231_CHECK_AND_RETURN_ERROR(error);  \
 	} while (0)
 #else
 #define DS3231_NULL_CHECK_MACRO(handle, error) ;
 #endif
 
-
 #if DS3231_INCLUDE_WRITE_VERIFICATION
 /*Verify the written bit or byte*/
-#define DS3231_VERIFY_BIT(handle, error, register_address, bit_address, expected)                 \
-	do                                                                                            \
-	{                                                                                             \
-		error = _ds3231_write_verify_bit((handle), (register_address), (bit_address), (expected)); \
-		DS3231_CHECK_AND_RETURN_ERROR(error);                                                     \
+#define DS3231_VERIFY_BIT(handle, error, register_address, bit_address, expected)                      \
+	do                                                                                                 \
+	{                                                                                                  \
+		if (DS3231_POLICY_ENABLED(handle, DS3231_POLICY_SKIP_WRITE_VERIFICATION))                      \
+		{                                                                                              \
+			error = _ds3231_write_verify_bit((handle), (register_address), (bit_address), (expected)); \
+			DS3231_CHECK_AND_RETURN_ERROR(error);                                                      \
+		}                                                                                              \
 	} while (0)
-#define DS3231_VERIFY_BYTES(handle, error, register_address, expected, number_of_bytes)                 \
-	do                                                                                                  \
-	{                                                                                                   \
-		error = _ds3231_write_verify_bytes((handle), (register_address), (expected), (number_of_bytes)); \
-		DS3231_CHECK_AND_RETURN_ERROR(error);                                                           \
+#define DS3231_VERIFY_BYTES(handle, error, register_address, expected, number_of_bytes)                      \
+	do                                                                                                       \
+	{                                                                                                        \
+		if (DS3231_POLICY_ENABLED(handle, DS3231_POLICY_SKIP_WRITE_VERIFICATION))                            \
+		{                                                                                                    \
+			error = _ds3231_write_verify_bytes((handle), (register_address), (expected), (number_of_bytes)); \
+			DS3231_CHECK_AND_RETURN_ERROR(error);                                                            \
+		}                                                                                                    \
 	} while (0)
 #else
 #define DS3231_VERIFY_BIT(handle, error, register_address, bit_address, expected) ;
@@ -140,4 +180,3 @@ extern "C"
 #endif
 
 #endif
-
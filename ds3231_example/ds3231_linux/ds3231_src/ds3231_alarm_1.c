@@ -57,7 +57,7 @@ ds3231_error_code_t ds3231_alarm_1_init(const ds3231_handle_t *handle, const ds3
 	{
 	case DS3231_ALARM1_MATCH_SECOND:
 	{
-		DS3231_RANGE_ERROR(config->second, DS3231_SECONDS);
+		DS3231_RANGE_ERROR(handle, config->second, DS3231_SECONDS);
 		uint8_t data = config->second;
 		error = _ds3231_hex_to_bcd(&data);
 		DS3231_LOCK(handle);
@@ -72,8 +72,8 @@ ds3231_error_code_t ds3231_alarm_1_init(const ds3231_handle_t *handle, const ds3
 	}
 	case DS3231_ALARM1_MATCH_SECOND_MINUTE:
 	{
-		DS3231_RANGE_ERROR(config->second, DS3231_SECONDS);
-		DS3231_RANGE_ERROR(config->minute, DS3231_MINUTES);
+		DS3231_RANGE_ERROR(handle, config->second, DS3231_SECONDS);
+		DS3231_RANGE_ERROR(handle, config->minute, DS3231_MINUTES);
 		uint8_t data = config->second;
 		error = _ds3231_hex_to_bcd(&data);
 		DS3231_LOCK(handle);
@@ -98,9 +98,9 @@ ds3231_error_code_t ds3231_alarm_1_init(const ds3231_handle_t *handle, const ds3
 	}
 	case DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR:
 	{
-		DS3231_RANGE_ERROR(config->second, DS3231_SECONDS);
-		DS3231_RANGE_ERROR(config->minute, DS3231_MINUTES);
-		DS3231_RANGE_ERROR(config->hour, DS3231_HOURS);
+		DS3231_RANGE_ERROR(handle, config->second, DS3231_SECONDS);
+		DS3231_RANGE_ERROR(handle, config->minute, DS3231_MINUTES);
+		DS3231_RANGE_ERROR(handle, config->hour, DS3231_HOURS);
 		uint8_t data = config->second;
 		error = _ds3231_hex_to_bcd(&data);
 		DS3231_LOCK(handle);
@@ -135,10 +135,10 @@ ds3231_error_code_t ds3231_alarm_1_init(const ds3231_handle_t *handle, const ds3
 	}
 	case DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR_DATE:
 	{
-		DS3231_RANGE_ERROR(config->second, DS3231_SECONDS);
-		DS3231_RANGE_ERROR(config->minute, DS3231_MINUTES);
-		DS3231_RANGE_ERROR(config->hour, DS3231_HOURS);
-		DS3231_RANGE_ERROR(config->day_date.date, DS3231_DATE);
+		DS3231_RANGE_ERROR(handle, config->second, DS3231_SECONDS);
+		DS3231_RANGE_ERROR(handle, config->minute, DS3231_MINUTES);
+		DS3231_RANGE_ERROR(handle, config->hour, DS3231_HOURS);
+		DS3231_RANGE_ERROR(handle, config->day_date.date, DS3231_DATE);
 		uint8_t data = config->second;
 		error = _ds3231_hex_to_bcd(&data);
 		DS3231_LOCK(handle);
@@ -169,8 +169,9 @@ ds3231_error_code_t ds3231_alarm_1_init(const ds3231_handle_t *handle, const ds3
 		}
 		DS3231_UNLOCK(handle);
 		DS3231_VERIFY_BYTES(handle, error, DS3231_REGISTER_ALARM1_HOURS, &data, 1);
+		data = config->day_date.date;
 		error = _ds3231_hex_to_bcd(&data);
-		data = config->day_date.date & (~(1 << DS3231_BIT_DY_DT_ALARM1));
+		data &= (uint8_t)(~(1 << DS3231_BIT_DY_DT_ALARM1));
 		DS3231_LOCK(handle);
 		if (handle->interface.write_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM1_DAY_OF_WEEK_OR_DATE, &data, 1) != 0)
 		{
@@ -183,10 +184,10 @@ ds3231_error_code_t ds3231_alarm_1_init(const ds3231_handle_t *handle, const ds3
 	}
 	case DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR_DAY:
 	{
-		DS3231_RANGE_ERROR(config->second, DS3231_SECONDS);
-		DS3231_RANGE_ERROR(config->minute, DS3231_MINUTES);
-		DS3231_RANGE_ERROR(config->hour, DS3231_HOURS);
-		DS3231_RANGE_ERROR(config->day_date.day, DS3231_DAY);
+		DS3231_RANGE_ERROR(handle, config->second, DS3231_SECONDS);
+		DS3231_RANGE_ERROR(handle, config->minute, DS3231_MINUTES);
+		DS3231_RANGE_ERROR(handle, config->hour, DS3231_HOURS);
+		DS3231_RANGE_ERROR(handle, config->day_date.day, DS3231_DAY);
 		uint8_t data = config->second;
 		error = _ds3231_hex_to_bcd(&data);
 		DS3231_LOCK(handle);
@@ -217,8 +218,9 @@ ds3231_error_code_t ds3231_alarm_1_init(const ds3231_handle_t *handle, const ds3
 		}
 		DS3231_UNLOCK(handle);
 		DS3231_VERIFY_BYTES(handle, error, DS3231_REGISTER_ALARM1_HOURS, &data, 1);
+		data = config->day_date.day;
 		error = _ds3231_hex_to_bcd(&data);
-		data = config->day_date.day | (1 << DS3231_BIT_DY_DT_ALARM1);
+		data |= (uint8_t)(1 << DS3231_BIT_DY_DT_ALARM1);
 		DS3231_LOCK(handle);
 		if (handle->interface.write_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM1_DAY_OF_WEEK_OR_DATE, &data, 1) != 0)
 		{
@@ -318,4 +320,233 @@ ds3231_error_code_t ds3231_alarm_1_flag_clear(const ds3231_handle_t *handle)
 	return DS3231_ERROR_OK;
 }
 
+/********************************************************/
+/********************************************************/
+void _ds3231_alarm_1_encode(const ds3231_alarm_1_config_t *config, uint8_t *data)
+{
+	data[0] = (uint8_t)config->second;
+	data[1] = (uint8_t)config->minute;
+	data[2] = (uint8_t)config->hour;
+	data[3] = (uint8_t)((config->day_date_type == DS3231_ALARM_DAY) ? config->day_date.day : config->day_date.date);
+
+	/*The mask bit of each register is its most significant bit, the day/date select bit is only in the last one*/
+	for (uint8_t index = 0; index < DS3231_NUMBER_OF_ALARM_1_REGISTERS; index++)
+	{
+		_ds3231_hex_to_bcd(&data[index]);
+		data[index] |= (uint8_t)(DS3231_ALARM_1_MASK_BITS[(int)config->alarm_rate][index] << DS3231_BIT_A1M4);
+	}
+	data[DS3231_NUMBER_OF_ALARM_1_REGISTERS - 1] |= (uint8_t)(DS3231_ALARM_1_MASK_BITS[(int)config->alarm_rate][DS3231_NUMBER_OF_ALARM_1_REGISTERS] << DS3231_BIT_DY_DT_ALARM1);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_alarm_1_get_config(const ds3231_handle_t *handle, ds3231_alarm_1_config_t *config)
+{
+#if DS3231_INCLUDE_NULL_CHECK
+	ds3231_error_code_t error;
+#endif
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t data[DS3231_NUMBER_OF_ALARM_1_REGISTERS];
+
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM1_SECONDS, data, DS3231_NUMBER_OF_ALARM_1_REGISTERS) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+	DS3231_UNLOCK(handle);
+
+	return _ds3231_alarm_1_decode(data, config);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_alarm_1_decode(const uint8_t *data, ds3231_alarm_1_config_t *config)
+{
+	uint8_t last = data[DS3231_NUMBER_OF_ALARM_1_REGISTERS - 1];
+	ds3231_bool_t day_date_masked = (ds3231_bool_t)((last >> DS3231_BIT_A1M4) & 1);
+	ds3231_bool_t day_selected = (ds3231_bool_t)((last >> DS3231_BIT_DY_DT_ALARM1) & 1);
+	uint8_t rate;
+
+	/*The rate whose mask bits are the ones read, the day/date select bit only counts when the day/date is not masked*/
+	for (rate = 0; rate < (sizeof(DS3231_ALARM_1_MASK_BITS) / sizeof(DS3231_ALARM_1_MASK_BITS[0])); rate++)
+	{
+		uint8_t index;
+
+		for (index = 0; index < DS3231_NUMBER_OF_ALARM_1_REGISTERS; index++)
+		{
+			if (DS3231_ALARM_1_MASK_BITS[rate][index] != ((data[index] >> DS3231_BIT_A1M4) & 1))
+			{
+				break;
+			}
+		}
+
+		if ((index == DS3231_NUMBER_OF_ALARM_1_REGISTERS) && ((day_date_masked == DS3231_TRUE) || (DS3231_ALARM_1_MASK_BITS[rate][DS3231_NUMBER_OF_ALARM_1_REGISTERS] == day_selected)))
+		{
+			break;
+		}
+	}
+
+	if (rate == (sizeof(DS3231_ALARM_1_MASK_BITS) / sizeof(DS3231_ALARM_1_MASK_BITS[0])))
+	{
+		return DS3231_ERROR_ALARM_INVALID_MASK;
+	}
+
+	/*The seconds and minutes have 7 value bits, the hours 6 in 24 hour mode, the date 6 and the day 4*/
+	config->second = _ds3231_alarm_register_value(data[0], 0x7F);
+	config->minute = _ds3231_alarm_register_value(data[1], 0x7F);
+	config->hour = _ds3231_alarm_register_value(data[2], 0x3F);
+	if (day_selected == DS3231_TRUE)
+	{
+		config->day_date.day = (ds3231_day_t)_ds3231_alarm_register_value(last, 0x0F);
+		config->day_date_type = DS3231_ALARM_DAY;
+	}
+	else
+	{
+		config->day_date.date = _ds3231_alarm_register_value(last, 0x3F);
+		config->day_date_type = DS3231_ALARM_DATE;
+	}
+	config->alarm_rate = (ds3231_alarm_1_rate_t)rate;
+
+	return DS3231_ERROR_OK;
+}
+
+#if DS3231_INCLUDE_CALENDAR
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_alarm_1_next_fire(const ds3231_alarm_1_config_t *config, const ds3231_epoch_t now, ds3231_epoch_t *next_fire)
+{
+	ds3231_epoch_t second_of_day = (ds3231_epoch_t)config->hour * DS3231_SECONDS_PER_HOUR + (ds3231_epoch_t)config->minute * DS3231_SECONDS_PER_MINUTE + (ds3231_epoch_t)config->second;
+
+	/*Every rate but the date is periodic, with the match at a fixed offset into the period*/
+	switch (config->alarm_rate)
+	{
+	case DS3231_ALARM1_ONCE_PER_SECOND:
+		*next_fire = now + 1;
+		break;
+	case DS3231_ALARM1_MATCH_SECOND:
+		DS3231_VALUE_RANGE_ERROR(config->second, DS3231_SECONDS);
+		*next_fire = _ds3231_next_periodic_match(now, DS3231_SECONDS_PER_MINUTE, config->second);
+		break;
+	case DS3231_ALARM1_MATCH_SECOND_MINUTE:
+		DS3231_VALUE_RANGE_ERROR(config->second, DS3231_SECONDS);
+		DS3231_VALUE_RANGE_ERROR(config->minute, DS3231_MINUTES);
+		*next_fire = _ds3231_next_periodic_match(now, DS3231_SECONDS_PER_HOUR, second_of_day % DS3231_SECONDS_PER_HOUR);
+		break;
+	case DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR:
+		DS3231_VALUE_RANGE_ERROR(config->second, DS3231_SECONDS);
+		DS3231_VALUE_RANGE_ERROR(config->minute, DS3231_MINUTES);
+		DS3231_VALUE_RANGE_ERROR(config->hour, DS3231_HOURS);
+		*next_fire = _ds3231_next_periodic_match(now, DS3231_SECONDS_PER_DAY, second_of_day);
+		break;
+	case DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR_DATE:
+		if (config->day_date_type == DS3231_ALARM_DAY)
+		{
+			return DS3231_ERROR_ALARM_RATE_AND_DAY_DATE_MISMATCH;
+		}
+		DS3231_VALUE_RANGE_ERROR(config->second, DS3231_SECONDS);
+		DS3231_VALUE_RANGE_ERROR(config->minute, DS3231_MINUTES);
+		DS3231_VALUE_RANGE_ERROR(config->hour, DS3231_HOURS);
+		DS3231_VALUE_RANGE_ERROR(config->day_date.date, DS3231_DATE);
+		return _ds3231_next_date_match(now, config->day_date.date, (int32_t)second_of_day, next_fire);
+	case DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR_DAY:
+		if (config->day_date_type == DS3231_ALARM_DATE)
+		{
+			return DS3231_ERROR_ALARM_RATE_AND_DAY_DATE_MISMATCH;
+		}
+		DS3231_VALUE_RANGE_ERROR(config->second, DS3231_SECONDS);
+		DS3231_VALUE_RANGE_ERROR(config->minute, DS3231_MINUTES);
+		DS3231_VALUE_RANGE_ERROR(config->hour, DS3231_HOURS);
+		DS3231_VALUE_RANGE_ERROR(config->day_date.day, DS3231_DAY);
+		/*Day 0 of the epoch is a thursday, the week period starts there*/
+		*next_fire = _ds3231_next_periodic_match(now, (ds3231_epoch_t)DS3231_DAYS_PER_WEEK * DS3231_SECONDS_PER_DAY,
+												 (ds3231_epoch_t)((config->day_date.day - DS3231_EPOCH_DAY_OF_WEEK + DS3231_DAYS_PER_WEEK) % DS3231_DAYS_PER_WEEK) * DS3231_SECONDS_PER_DAY + second_of_day);
+		break;
+	default:
+		return DS3231_ERROR_ALARM_NEVER_MATCHES;
+	}
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_alarm_at(const ds3231_handle_t *handle, const ds3231_epoch_t now, const ds3231_epoch_t epoch)
+{
+	return _ds3231_alarm_1_program_epoch(handle, now, epoch);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_alarm_in(const ds3231_handle_t *handle, const ds3231_epoch_t now, const uint32_t seconds)
+{
+	return _ds3231_alarm_1_program_epoch(handle, now, now + (ds3231_epoch_t)seconds);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_alarm_1_program_epoch(const ds3231_handle_t *handle, const ds3231_epoch_t now, const ds3231_epoch_t epoch)
+{
+#if DS3231_INCLUDE_WRITE_VERIFICATION | DS3231_INCLUDE_NULL_CHECK
+	ds3231_error_code_t error;
+#endif
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t data[DS3231_NUMBER_OF_REGISTERS_TO_STATUS];
+	ds3231_time_and_calendar_t time_struct;
+	ds3231_alarm_1_config_t config;
+	ds3231_epoch_t next_fire = 0;
+
+	/*The date match is the tightest rate, it reaches every epoch a day match does and then some, as a date comes back 28 days later at the earliest*/
+	ds3231_epoch_to_time_and_calendar(epoch, &time_struct);
+	config.second = time_struct.second;
+	config.minute = time_struct.minute;
+	config.hour = time_struct.hour;
+	config.day_date.date = time_struct.date;
+	config.day_date_type = DS3231_ALARM_DATE;
+	config.alarm_rate = DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR_DATE;
+
+	/*The alarm must not fire before the epoch, i.e. the epoch is the first match after now*/
+	if ((epoch <= now) || (ds3231_alarm_1_next_fire(&config, now, &next_fire) != DS3231_ERROR_OK) || (next_fire != epoch))
+	{
+		return DS3231_ERROR_ALARM_OUT_OF_REACH;
+	}
+	_ds3231_alarm_1_encode(&config, &data[DS3231_REGISTER_ALARM1_SECONDS]);
+
+	/*The time is the caller's, only the control and status registers are read back, the lock is held up to the write so they are not stale*/
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_CONTROL, &data[DS3231_REGISTER_CONTROL], DS3231_CONTROL_AND_STATUS_LENGTH) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+
+	/*CONV is not restarted. A stale A1F is cleared and A2F is written as 1 to not lose a fire since the read*/
+	data[DS3231_REGISTER_CONTROL] &= (uint8_t)(~(1 << DS3231_BIT_CONV));
+	data[DS3231_REGISTER_CONTROL] |= (uint8_t)(1 << DS3231_BIT_A1IE);
+	data[DS3231_REGISTER_CONTROL_STATUS] &= (uint8_t)(~(1 << DS3231_BIT_A1F));
+	data[DS3231_REGISTER_CONTROL_STATUS] |= (uint8_t)(1 << DS3231_BIT_A2F);
+
+	/*Alarm 1 first, so the interrupt is enabled on the new match and not on a stale one. Alarm 2 sits in between and is not touched*/
+	if (handle->interface.write_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM1_SECONDS, &data[DS3231_REGISTER_ALARM1_SECONDS], DS3231_NUMBER_OF_ALARM_1_REGISTERS) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_WRITE;
+	}
+	if (handle->interface.write_array((uint8_t)handle->i2c_address, DS3231_REGISTER_CONTROL, &data[DS3231_REGISTER_CONTROL], DS3231_CONTROL_AND_STATUS_LENGTH) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_WRITE;
+	}
+	DS3231_UNLOCK(handle);
+
+	DS3231_VERIFY_BYTES(handle, error, DS3231_REGISTER_ALARM1_SECONDS, &data[DS3231_REGISTER_ALARM1_SECONDS], DS3231_NUMBER_OF_ALARM_1_REGISTERS);
+
+	return DS3231_ERROR_OK;
+}
+#endif
+
 #endif
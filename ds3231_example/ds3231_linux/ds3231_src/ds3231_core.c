@@ -40,6 +40,10 @@ ds3231_error_code_t ds3231_init(ds3231_handle_t *handle)
 	DS3231_NULL_CHECK_MACRO(handle, error);
 
 	handle->i2c_address = DS3231_I2C_ADDRESS;
+#if DS3231_INCLUDE_RUNTIME_POLICY
+	/*All the compiled in checks, the policy can be changed after init*/
+	handle->policy = DS3231_POLICY_SAFE;
+#endif
 
 	/*initialize the interface*/
 	DS3231_LOCK(handle);
@@ -166,7 +170,7 @@ ds3231_error_code_t _ds3231_set_time_and_calendar(const ds3231_handle_t *handle,
 	DS3231_CONNECTION_CHECK(handle);
 
 	/*Check for error in range*/
-	DS3231_RANGE_ERROR(value, time_register);
+	DS3231_RANGE_ERROR(handle, value, time_register);
 
 	/*Determine the century bit in case of year and trim the 16 bit year value into the range of 0 to 99*/
 	ds3231_bool_t century_bit = DS3231_FALSE;
@@ -191,7 +195,8 @@ ds3231_error_code_t _ds3231_set_time_and_calendar(const ds3231_handle_t *handle,
 	uint8_t data;
 	DS3231_LOCK(handle);
 	if (handle->interface.read_array((uint8_t)handle->i2c_address, (uint8_t)time_register, &data, 1) != 0)
-	{
+	{
+  DS3231_UNLOCK(handle);
 		return DS3231_ERROR_INTERFACE_READ;
 	}
 	DS3231_UNLOCK(handle);
@@ -232,14 +237,8 @@ ds3231_error_code_t ds3231_set_all_time_and_calendar(const ds3231_handle_t *hand
 	DS3231_NULL_CHECK_MACRO(handle, error);
 	DS3231_CONNECTION_CHECK(handle);
 
-	/*Check for error in range*/
-	DS3231_RANGE_ERROR(time_struct->second, DS3231_SECONDS);
-	DS3231_RANGE_ERROR(time_struct->minute, DS3231_MINUTES);
-	DS3231_RANGE_ERROR(time_struct->hour, DS3231_HOURS);
-	DS3231_RANGE_ERROR(time_struct->day, DS3231_DAY);
-	DS3231_RANGE_ERROR(time_struct->date, DS3231_DATE);
-	DS3231_RANGE_ERROR(time_struct->month, DS3231_MONTH);
-	DS3231_RANGE_ERROR(time_struct->year, DS3231_YEAR);
+	/*Check for error in range, including the last date of the month*/
+	DS3231_TIME_STRUCT_RANGE_ERROR(handle, time_struct);
 
 	ds3231_bool_t century_bit;
 
@@ -266,11 +265,8 @@ ds3231_error_code_t ds3231_set_all_time_and_calendar(const ds3231_handle_t *hand
 	value_in_bcd[DS3231_MONTH] = (uint8_t)time_struct->month;
 	value_in_bcd[DS3231_YEAR] = (uint8_t)time_struct->year;
 
-	for (int index = DS3231_SECONDS; index <= DS3231_YEAR; index++)
-	{
-		error = _ds3231_hex_to_bcd(&value_in_bcd[index]);
-		DS3231_CHECK_AND_RETURN_ERROR(error);
-	}
+	error = _ds3231_time_block_hex_to_bcd(value_in_bcd);
+	DS3231_CHECK_AND_RETURN_ERROR(error);
 
 	/*Read the time registers*/
 	uint8_t data[DS3231_NUMBER_OF_TIME_REGISTERS];
@@ -358,7 +354,7 @@ ds3231_error_code_t _ds3231_get_time_and_calendar(const ds3231_handle_t *handle,
 	}
 
 	/*Check data range*/
-	DS3231_RANGE_ERROR(data_16_bit, time_register);
+	DS3231_RANGE_ERROR(handle, data_16_bit, time_register);
 
 	/*Copy the data*/
 	*value = data_16_bit;
@@ -390,43 +386,34 @@ ds3231_error_code_t ds3231_get_all_time_and_calendar(const ds3231_handle_t *hand
 	error = _ds3231_bit_get(handle, DS3231_REGISTER_MONTH, DS3231_BIT_CENTURY, &century_bit);
 	DS3231_CHECK_AND_RETURN_ERROR(error);
 
-	/*Iterate, mask and range-check all the data*/
-	for (int index = (int)DS3231_SECONDS; index <= (int)DS3231_YEAR; index++)
-	{
-		data[index] &= DS3231_MASK_AND_RANGE_LUT[index].mask;
-
-		error = _ds3231_bcd_to_hex(&data[index]);
-		DS3231_CHECK_AND_RETURN_ERROR(error);
-
-		/*Do not range-check the year*/
-		if (index == DS3231_YEAR)
-		{
-			continue;
-		}
+	/*Mask and convert all the data at once*/
+	error = _ds3231_time_block_bcd_to_hex(data);
+	DS3231_CHECK_AND_RETURN_ERROR(error);
 
-		DS3231_RANGE_ERROR(data[index], index);
-	}
+	/*Copy the data into a local time-struct*/
+	ds3231_time_and_calendar_t time_read;
 
-	/*Copy the data into the time-struct*/
-	time_struct->second = (uint16_t)data[DS3231_SECONDS];
-	time_struct->minute = (uint16_t)data[DS3231_MINUTES];
-	time_struct->hour = (uint16_t)data[DS3231_HOURS];
-	time_struct->day = (ds3231_day_t)data[DS3231_DAY];
-	time_struct->date = (uint16_t)data[DS3231_DATE];
-	time_struct->month = (ds3231_month_t)data[DS3231_MONTH];
-	time_struct->year = (uint16_t)data[DS3231_YEAR];
+	time_read.second = (uint16_t)data[DS3231_SECONDS];
+	time_read.minute = (uint16_t)data[DS3231_MINUTES];
+	time_read.hour = (uint16_t)data[DS3231_HOURS];
+	time_read.day = (ds3231_day_t)data[DS3231_DAY];
+	time_read.date = (uint16_t)data[DS3231_DATE];
+	time_read.month = (ds3231_month_t)data[DS3231_MONTH];
+	time_read.year = (uint16_t)data[DS3231_YEAR];
 
 	if (century_bit == 0)
 	{
-		time_struct->year += 2000;
+		time_read.year += 2000;
 	}
 	else
 	{
-		time_struct->year += 1900;
+		time_read.year += 1900;
 	}
 
-	/*Range-check the year*/
-	DS3231_RANGE_ERROR(time_struct->year, DS3231_YEAR);
+	/*Range-check all the data at once, the caller's struct is left untouched on error*/
+	DS3231_TIME_STRUCT_RANGE_ERROR(handle, &time_read);
+
+	*time_struct = time_read;
 
 	return DS3231_ERROR_OK;
 }
@@ -490,12 +477,54 @@ ds3231_error_code_t ds3231_int_sqw_pin_select(const ds3231_handle_t *handle, con
 	return DS3231_ERROR_OK;
 }
 
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_ALARM_1 | DS3231_INCLUDE_ALARM_2
+ds3231_error_code_t ds3231_alarm_flags_fetch_and_clear(const ds3231_handle_t *handle, ds3231_bool_t *alarm_1_flag, ds3231_bool_t *alarm_2_flag)
+{
+#if DS3231_INCLUDE_NULL_CHECK
+	ds3231_error_code_t error;
+#endif
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t status;
+	uint8_t flags = (uint8_t)((1 << DS3231_BIT_A1F) | (1 << DS3231_BIT_A2F));
+
+	/*The lock is held from the read to the write, so OSF and EN32KHZ written back are not stale*/
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_CONTROL_STATUS, &status, 1) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+
+	*alarm_1_flag = (ds3231_bool_t)((status >> DS3231_BIT_A1F) & 1);
+	*alarm_2_flag = (ds3231_bool_t)((status >> DS3231_BIT_A2F) & 1);
+
+	/*The flags can only be cleared, the ones read set are cleared and the others written as 1 to not lose a fire since the read*/
+	if ((status & flags) != 0)
+	{
+		status ^= flags;
+		if (handle->interface.write_array((uint8_t)handle->i2c_address, DS3231_REGISTER_CONTROL_STATUS, &status, 1) != 0)
+		{
+			DS3231_UNLOCK(handle);
+			return DS3231_ERROR_INTERFACE_WRITE;
+		}
+	}
+	DS3231_UNLOCK(handle);
+
+	/*No read back, an alarm that fires meanwhile sets its flag again*/
+	return DS3231_ERROR_OK;
+}
+#endif
+
 /********************************************************/
 /********************************************************/
 #if DS3231_INCLUDE_AGING_OFFSET_CALIBRATION
 ds3231_error_code_t ds3231_aging_offset_calibration(const ds3231_handle_t *handle, const int8_t offset)
 {
-#if DS3231_INCLUDE_SAFE_RANGE_CHECK | DS3231_INCLUDE_WRITE_VERIFICATION
+#if DS3231_INCLUDE_SAFE_RANGE_CHECK | DS3231_INCLUDE_WRITE_VERIFICATION | DS3231_INCLUDE_NULL_CHECK
 	ds3231_error_code_t error;
 #endif
 	DS3231_NULL_CHECK_MACRO(handle, error);
@@ -515,6 +544,31 @@ ds3231_error_code_t ds3231_aging_offset_calibration(const ds3231_handle_t *handl
 
 	return DS3231_ERROR_OK;
 }
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_get_aging_offset(const ds3231_handle_t *handle, int8_t *offset)
+{
+#if DS3231_INCLUDE_NULL_CHECK
+	ds3231_error_code_t error;
+#endif
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t data;
+
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_AGING_OFFSET, &data, 1) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+	DS3231_UNLOCK(handle);
+
+	*offset = (int8_t)data;
+
+	return DS3231_ERROR_OK;
+}
 #endif
 
 /********************************************************/
@@ -549,6 +603,48 @@ ds3231_error_code_t ds3231_battery_backed_sqw_control(const ds3231_handle_t *han
 	return DS3231_ERROR_OK;
 }
 
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_get_status_block(const ds3231_handle_t *handle, ds3231_status_block_t *block)
+{
+#if DS3231_INCLUDE_NULL_CHECK
+	ds3231_error_code_t error;
+#endif
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	/*data[0] is control, data[1] status, data[2] aging offset, data[3] and data[4] the temperature MSB and LSB*/
+	uint8_t data[DS3231_STATUS_BLOCK_LENGTH];
+
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_CONTROL, data, DS3231_STATUS_BLOCK_LENGTH) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+	DS3231_UNLOCK(handle);
+
+	block->battery_backed_oscillator = (ds3231_bool_t)((data[0] >> DS3231_BIT_EOSC) & 1);
+	block->battery_backed_sqw = (ds3231_bool_t)((data[0] >> DS3231_BIT_BBSQW) & 1);
+	block->converting = (ds3231_bool_t)((data[0] >> DS3231_BIT_CONV) & 1);
+	block->sqw_frequency = (ds3231_sqw_output_wave_frequency_t)((data[0] >> DS3231_BIT_RS1) & 3);
+	block->int_sqw_pin = (ds3231_int_sqw_pin_t)((data[0] >> DS3231_BIT_INTCN) & 1);
+	block->alarm_2_interrupt = (ds3231_bool_t)((data[0] >> DS3231_BIT_A2IE) & 1);
+	block->alarm_1_interrupt = (ds3231_bool_t)((data[0] >> DS3231_BIT_A1IE) & 1);
+
+	block->oscillator_stopped = (ds3231_bool_t)((data[1] >> DS3231_BIT_OSF) & 1);
+	block->wave_32khz = (ds3231_bool_t)((data[1] >> DS3231_BIT_EN32KHZ) & 1);
+	block->busy = (ds3231_bool_t)((data[1] >> DS3231_BIT_BSY) & 1);
+	block->alarm_2_flag = (ds3231_bool_t)((data[1] >> DS3231_BIT_A2F) & 1);
+	block->alarm_1_flag = (ds3231_bool_t)((data[1] >> DS3231_BIT_A1F) & 1);
+
+	block->aging_offset = (int8_t)data[2];
+
+	block->temperature = _ds3231_temperature_raw(&data[3]);
+
+	return DS3231_ERROR_OK;
+}
+
 /********************************************************/
 /********************************************************/
 #if DS3231_INCLUDE_ERROR_LOG_STRINGS
@@ -0,0 +1,208 @@
+/**
+ * @file ds3231_drift.c
+ * @brief DS3231 Real Time Clock C Driver
+ * @author Reza G. Ebrahimi <https://github.com/ebrezadev>
+ * @version 2.0
+ * @license MIT
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Reza G. Ebrahimi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "ds3231.h"
+#include "ds3231_macros.h"
+
+
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_DRIFT_ESTIMATION
+ds3231_error_code_t ds3231_drift_init(const ds3231_handle_t *handle, ds3231_drift_t *drift)
+{
+	ds3231_error_code_t error;
+
+	ds3231_drift_reset_history(drift);
+	drift->drift_ppb = 0;
+
+	error = ds3231_get_aging_offset(handle, &drift->aging_offset);
+	DS3231_CHECK_AND_RETURN_ERROR(error);
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+void ds3231_drift_reset_history(ds3231_drift_t *drift)
+{
+	drift->sample_count = 0;
+	drift->next_sample = 0;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_drift_sample(const ds3231_handle_t *handle, ds3231_drift_t *drift, ds3231_reference_clock_fp reference_clock)
+{
+	ds3231_error_code_t error;
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	ds3231_phase_t phase;
+
+	/*The edge is located with sparse short reads instead of polling the time block*/
+	error = ds3231_measure_phase(handle, reference_clock, DS3231_DRIFT_EDGE_UNCERTAINTY_NS, &phase);
+	if (error == DS3231_ERROR_SYNC_EDGE_TIMEOUT)
+	{
+		return DS3231_ERROR_DRIFT_EDGE_TIMEOUT;
+	}
+	DS3231_CHECK_AND_RETURN_ERROR(error);
+
+	ds3231_drift_sample_t *sample = &drift->samples[drift->next_sample];
+
+	sample->rtc_epoch = phase.rtc_epoch;
+	sample->reference_ns = phase.edge_ns;
+
+	drift->next_sample = (uint8_t)((drift->next_sample + 1) % DS3231_DRIFT_HISTORY_LENGTH);
+	if (drift->sample_count < DS3231_DRIFT_HISTORY_LENGTH)
+	{
+		drift->sample_count++;
+	}
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_drift_estimate(const ds3231_drift_t *drift, int32_t *drift_ppb)
+{
+	int32_t slopes[DS3231_DRIFT_HISTORY_LENGTH * (DS3231_DRIFT_HISTORY_LENGTH - 1) / 2];
+	uint16_t number_of_slopes = 0;
+
+	if (drift->sample_count < DS3231_DRIFT_MIN_SAMPLES)
+	{
+		return DS3231_ERROR_DRIFT_NOT_ENOUGH_SAMPLES;
+	}
+
+	/*The slope of the RTC offset against the reference for every pair far enough apart, sorted as it goes*/
+	for (uint8_t first = 0; first < drift->sample_count; first++)
+	{
+		for (uint8_t second = (uint8_t)(first + 1); second < drift->sample_count; second++)
+		{
+			const ds3231_drift_sample_t *sample_1 = &drift->samples[first];
+			const ds3231_drift_sample_t *sample_2 = &drift->samples[second];
+
+			int64_t reference_interval_ns = sample_2->reference_ns - sample_1->reference_ns;
+			int64_t reference_interval_ms = reference_interval_ns / 1000000;
+
+			if ((reference_interval_ns < (int64_t)DS3231_DRIFT_MIN_PAIR_INTERVAL_S * DS3231_NS_PER_SECOND) &&
+				(reference_interval_ns > -(int64_t)DS3231_DRIFT_MIN_PAIR_INTERVAL_S * DS3231_NS_PER_SECOND))
+			{
+				continue;
+			}
+
+			int64_t offset_change_ns = (sample_2->rtc_epoch - sample_1->rtc_epoch) * DS3231_NS_PER_SECOND - reference_interval_ns;
+			int64_t slope = (offset_change_ns * 1000) / reference_interval_ms;
+
+			/*Clamp, a slope this large is an outlier anyway*/
+			slope = (slope > INT32_MAX) ? INT32_MAX : ((slope < INT32_MIN) ? INT32_MIN : slope);
+
+			uint16_t index = number_of_slopes++;
+			for (; (index > 0) && (slopes[index - 1] > (int32_t)slope); index--)
+			{
+				slopes[index] = slopes[index - 1];
+			}
+			slopes[index] = (int32_t)slope;
+		}
+	}
+
+	if (number_of_slopes == 0)
+	{
+		return DS3231_ERROR_DRIFT_NOT_ENOUGH_SAMPLES;
+	}
+
+	/*Theil-Sen, the median of the slopes*/
+	if (number_of_slopes % 2)
+	{
+		*drift_ppb = slopes[number_of_slopes / 2];
+	}
+	else
+	{
+		*drift_ppb = (int32_t)(((int64_t)slopes[number_of_slopes / 2 - 1] + slopes[number_of_slopes / 2]) / 2);
+	}
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_drift_update(const ds3231_handle_t *handle, ds3231_drift_t *drift, ds3231_reference_clock_fp reference_clock, ds3231_bool_t *applied)
+{
+	ds3231_error_code_t error;
+	int32_t drift_ppb;
+
+	*applied = DS3231_FALSE;
+
+	error = ds3231_drift_sample(handle, drift, reference_clock);
+	DS3231_CHECK_AND_RETURN_ERROR(error);
+
+	/*Not enough history yet is not an error here, just wait for the next update*/
+	error = ds3231_drift_estimate(drift, &drift_ppb);
+	if (error == DS3231_ERROR_DRIFT_NOT_ENOUGH_SAMPLES)
+	{
+		return DS3231_ERROR_OK;
+	}
+	DS3231_CHECK_AND_RETURN_ERROR(error);
+
+	drift->drift_ppb = drift_ppb;
+
+	/*Hysteresis, leave the aging offset alone for a drift inside the band*/
+	if ((drift_ppb <= DS3231_DRIFT_HYSTERESIS_PPB) && (drift_ppb >= -DS3231_DRIFT_HYSTERESIS_PPB))
+	{
+		return DS3231_ERROR_OK;
+	}
+
+	/*A fast DS3231 needs a larger aging offset to slow it down. Round to the nearest LSB*/
+	int32_t correction = (drift_ppb + ((drift_ppb > 0) ? 1 : -1) * (DS3231_AGING_OFFSET_PPB_PER_LSB / 2)) / DS3231_AGING_OFFSET_PPB_PER_LSB;
+	int32_t aging_offset = (int32_t)drift->aging_offset + correction;
+
+	aging_offset = (aging_offset > INT8_MAX) ? INT8_MAX : ((aging_offset < INT8_MIN) ? INT8_MIN : aging_offset);
+
+	if (aging_offset == drift->aging_offset)
+	{
+		return DS3231_ERROR_OK;
+	}
+
+	error = ds3231_aging_offset_calibration(handle, (int8_t)aging_offset);
+	DS3231_CHECK_AND_RETURN_ERROR(error);
+
+	drift->aging_offset = (int8_t)aging_offset;
+	*applied = DS3231_TRUE;
+
+	/*The old samples measured the old frequency. The last edge is still a valid start for the new history*/
+	ds3231_drift_sample_t last_sample = drift->samples[(drift->next_sample + DS3231_DRIFT_HISTORY_LENGTH - 1) % DS3231_DRIFT_HISTORY_LENGTH];
+
+	ds3231_drift_reset_history(drift);
+	drift->samples[0] = last_sample;
+	drift->sample_count = 1;
+	drift->next_sample = 1;
+
+	return DS3231_ERROR_OK;
+}
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @file ds3231_interval_alarm.c
+ * @brief DS3231 Real Time Clock C Driver
+ * @author Reza G. Ebrahimi <https://github.com/ebrezadev>
+ * @version 2.0
+ * @license MIT
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Reza G. Ebrahimi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "ds3231.h"
+#include "ds3231_macros.h"
+
+
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_INTERVAL_ALARM
+ds3231_error_code_t ds3231_interval_alarm_start(const ds3231_handle_t *handle, ds3231_interval_alarm_t *interval_alarm, const uint32_t interval, const uint32_t phase)
+{
+	ds3231_bool_t armed;
+
+	interval_alarm->interval = (interval == 0) ? 1 : interval;
+	interval_alarm->phase = phase % interval_alarm->interval;
+	interval_alarm->rearm_ns = 0;
+	interval_alarm->late_s = 0;
+	interval_alarm->missed = 0;
+
+	return _ds3231_interval_alarm_arm(handle, interval_alarm, DS3231_TRUE, &armed);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_interval_alarm_rearm(const ds3231_handle_t *handle, ds3231_interval_alarm_t *interval_alarm, ds3231_bool_t *fired)
+{
+	return _ds3231_interval_alarm_arm(handle, interval_alarm, DS3231_FALSE, fired);
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_interval_alarm_arm(const ds3231_handle_t *handle, ds3231_interval_alarm_t *interval_alarm, const ds3231_bool_t start, ds3231_bool_t *fired)
+{
+#if DS3231_INCLUDE_WRITE_VERIFICATION | DS3231_INCLUDE_NULL_CHECK
+	ds3231_error_code_t error;
+#endif
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t data[DS3231_NUMBER_OF_REGISTERS_TO_STATUS];
+	int64_t start_ns = (interval_alarm->reference_clock != NULL) ? interval_alarm->reference_clock() : 0;
+
+	*fired = DS3231_FALSE;
+
+	/*The lock is held from the read to the write, so the control and status registers written back are not stale*/
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_SECONDS, data, DS3231_NUMBER_OF_REGISTERS_TO_STATUS) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+
+	/*Alarm 2 may share the interrupt, leave everything alone if alarm 1 didn't fire*/
+	if ((start == DS3231_FALSE) && ((data[DS3231_REGISTER_CONTROL_STATUS] & (1 << DS3231_BIT_A1F)) == 0))
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_OK;
+	}
+
+	ds3231_epoch_t now = _ds3231_epoch_from_time_block(data);
+	ds3231_epoch_t next_fire = _ds3231_next_periodic_match(now, interval_alarm->interval, interval_alarm->phase);
+
+	/*The date matches in every month, an interval longer than the shortest month fires early in an earlier one and is armed again for the same fire*/
+	ds3231_bool_t due = ((start == DS3231_TRUE) || (now >= interval_alarm->next_fire)) ? DS3231_TRUE : DS3231_FALSE;
+	ds3231_time_and_calendar_t time_struct;
+	ds3231_alarm_1_config_t config;
+
+	/*Match the full date, a re-arm that comes late still can't fire early*/
+	ds3231_epoch_to_time_and_calendar(next_fire, &time_struct);
+	config.second = time_struct.second;
+	config.minute = time_struct.minute;
+	config.hour = time_struct.hour;
+	config.day_date.date = time_struct.date;
+	config.day_date_type = DS3231_ALARM_DATE;
+	config.alarm_rate = DS3231_ALARM1_MATCH_SECOND_MINUTE_HOUR_DATE;
+	_ds3231_alarm_1_encode(&config, &data[DS3231_REGISTER_ALARM1_SECONDS]);
+
+	/*Alarm 2 is written back as read, CONV is not restarted. The flags can only be cleared, so A2F is written as 1 to not lose a fire since the read*/
+	data[DS3231_REGISTER_CONTROL] &= (uint8_t)(~(1 << DS3231_BIT_CONV));
+	if (start == DS3231_TRUE)
+	{
+		data[DS3231_REGISTER_CONTROL] |= (uint8_t)(1 << DS3231_BIT_A1IE);
+	}
+	data[DS3231_REGISTER_CONTROL_STATUS] &= (uint8_t)(~(1 << DS3231_BIT_A1F));
+	data[DS3231_REGISTER_CONTROL_STATUS] |= (uint8_t)(1 << DS3231_BIT_A2F);
+
+	if (handle->interface.write_array((uint8_t)handle->i2c_address, DS3231_REGISTER_ALARM1_SECONDS, &data[DS3231_REGISTER_ALARM1_SECONDS], DS3231_ALARM_1_WRITE_LENGTH) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_WRITE;
+	}
+	DS3231_UNLOCK(handle);
+
+	if (interval_alarm->reference_clock != NULL)
+	{
+		interval_alarm->rearm_ns = interval_alarm->reference_clock() - start_ns;
+	}
+
+	if ((start == DS3231_FALSE) && (due == DS3231_TRUE))
+	{
+		/*Every fire between the one armed and now was missed*/
+		ds3231_epoch_t late = now - interval_alarm->next_fire;
+		interval_alarm->late_s = (late > 0) ? (uint32_t)late : 0;
+		interval_alarm->missed += interval_alarm->late_s / interval_alarm->interval;
+	}
+	interval_alarm->next_fire = next_fire;
+	*fired = due;
+
+	DS3231_VERIFY_BYTES(handle, error, DS3231_REGISTER_ALARM1_SECONDS, &data[DS3231_REGISTER_ALARM1_SECONDS], DS3231_NUMBER_OF_ALARM_1_REGISTERS);
+
+	return DS3231_ERROR_OK;
+}
+
+#endif
@@ -0,0 +1,303 @@
+/**
+ * @file ds3231_sample_store.c
+ * @brief DS3231 Real Time Clock C Driver
+ * @author Reza G. Ebrahimi <https://github.com/ebrezadev>
+ * @version 2.0
+ * @license MIT
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Reza G. Ebrahimi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "ds3231.h"
+#include "ds3231_macros.h"
+
+
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_SAMPLE_STORE
+void ds3231_sample_store_init(ds3231_sample_store_t *store)
+{
+	store->head = 0;
+	store->used = 0;
+	store->count = 0;
+	store->oldest.time = 0;
+	store->oldest.temperature = 0;
+	store->oldest_interval = 0;
+	store->newest = store->oldest;
+	store->newest_interval = 0;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_sample_store_append(ds3231_sample_store_t *store, const ds3231_epoch_t time, const int16_t temperature)
+{
+	uint8_t record[DS3231_SAMPLE_RECORD_MAX_LENGTH];
+	uint8_t length;
+	int64_t interval;
+
+	if (store->count == 0)
+	{
+		store->oldest.time = time;
+		store->oldest.temperature = temperature;
+		store->oldest_interval = 0;
+		store->newest = store->oldest;
+		store->newest_interval = 0;
+		store->count = 1;
+
+		return DS3231_ERROR_OK;
+	}
+
+	interval = time - store->newest.time;
+	length = _ds3231_varint_encode(interval - store->newest_interval, record);
+	length += _ds3231_varint_encode((int32_t)temperature - store->newest.temperature, &record[length]);
+
+	/*The oldest sample is replaced by the one after it, until the record fits*/
+	while ((DS3231_SAMPLE_STORE_SIZE - store->used) < length)
+	{
+		int64_t delta_of_delta;
+		int16_t temperature_delta;
+		uint16_t next = _ds3231_sample_record_decode(store, store->head, &delta_of_delta, &temperature_delta);
+
+		store->oldest_interval += delta_of_delta;
+		store->oldest.time += store->oldest_interval;
+		store->oldest.temperature += temperature_delta;
+		store->used -= (uint16_t)((next + DS3231_SAMPLE_STORE_SIZE - store->head) % DS3231_SAMPLE_STORE_SIZE);
+		store->head = next;
+		store->count--;
+	}
+
+	uint16_t offset = (uint16_t)((store->head + store->used) % DS3231_SAMPLE_STORE_SIZE);
+
+	for (uint8_t index = 0; index < length; index++)
+	{
+		store->buffer[offset] = record[index];
+		offset = (uint16_t)((offset + 1) % DS3231_SAMPLE_STORE_SIZE);
+	}
+
+	store->used += length;
+	store->count++;
+	store->newest.time = time;
+	store->newest.temperature = temperature;
+	store->newest_interval = interval;
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_CALENDAR
+ds3231_error_code_t ds3231_sample_store_capture(const ds3231_handle_t *handle, ds3231_sample_store_t *store)
+{
+#if DS3231_INCLUDE_NULL_CHECK
+	ds3231_error_code_t error;
+#endif
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t data[DS3231_SAMPLE_CAPTURE_LENGTH];
+
+	/*The time and the temperature in one transaction, no conversion is forced*/
+	DS3231_LOCK(handle);
+	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_SECONDS, data, DS3231_SAMPLE_CAPTURE_LENGTH) != 0)
+	{
+		DS3231_UNLOCK(handle);
+		return DS3231_ERROR_INTERFACE_READ;
+	}
+	DS3231_UNLOCK(handle);
+
+	return ds3231_sample_store_append(store, _ds3231_epoch_from_time_block(data), _ds3231_temperature_raw(&data[DS3231_REGISTER_TEMP_MSB]));
+}
+#endif
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_sample_store_first(const ds3231_sample_store_t *store, ds3231_sample_cursor_t *cursor)
+{
+	if (store->count == 0)
+	{
+		return DS3231_ERROR_SAMPLE_STORE_END;
+	}
+
+	cursor->sample = store->oldest;
+	cursor->interval = store->oldest_interval;
+	cursor->offset = store->head;
+	cursor->remaining = store->count - 1;
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_sample_store_next(const ds3231_sample_store_t *store, ds3231_sample_cursor_t *cursor)
+{
+	int64_t delta_of_delta;
+	int16_t temperature_delta;
+
+	if (cursor->remaining == 0)
+	{
+		return DS3231_ERROR_SAMPLE_STORE_END;
+	}
+
+	cursor->offset = _ds3231_sample_record_decode(store, cursor->offset, &delta_of_delta, &temperature_delta);
+	cursor->interval += delta_of_delta;
+	cursor->sample.time += cursor->interval;
+	cursor->sample.temperature += temperature_delta;
+	cursor->remaining--;
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_sample_store_last(const ds3231_sample_store_t *store, ds3231_sample_cursor_t *cursor)
+{
+	if (store->count == 0)
+	{
+		return DS3231_ERROR_SAMPLE_STORE_END;
+	}
+
+	cursor->sample = store->newest;
+	cursor->interval = store->newest_interval;
+	cursor->offset = (uint16_t)((store->head + store->used) % DS3231_SAMPLE_STORE_SIZE);
+	cursor->remaining = store->count - 1;
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_sample_store_previous(const ds3231_sample_store_t *store, ds3231_sample_cursor_t *cursor)
+{
+	int64_t delta_of_delta;
+	int16_t temperature_delta;
+
+	if (cursor->remaining == 0)
+	{
+		return DS3231_ERROR_SAMPLE_STORE_END;
+	}
+
+	/*The record of the sample holds the deltas from the sample before it, they are undone in reverse*/
+	cursor->offset = _ds3231_sample_record_start(store, cursor->offset);
+	_ds3231_sample_record_decode(store, cursor->offset, &delta_of_delta, &temperature_delta);
+	cursor->sample.time -= cursor->interval;
+	cursor->sample.temperature -= temperature_delta;
+	cursor->interval -= delta_of_delta;
+	cursor->remaining--;
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_sample_store_recent(const ds3231_sample_store_t *store, ds3231_sample_t *samples, const uint16_t number_of_samples, uint16_t *count)
+{
+	ds3231_sample_cursor_t cursor;
+	uint16_t index = number_of_samples;
+
+	*count = 0;
+
+	if ((number_of_samples == 0) || (ds3231_sample_store_last(store, &cursor) != DS3231_ERROR_OK))
+	{
+		return DS3231_ERROR_OK;
+	}
+
+	/*Filled from the end of the array backward, then moved to its start*/
+	do
+	{
+		samples[--index] = cursor.sample;
+	} while ((index > 0) && (ds3231_sample_store_previous(store, &cursor) == DS3231_ERROR_OK));
+
+	*count = number_of_samples - index;
+	for (uint16_t sample = 0; (index > 0) && (sample < *count); sample++)
+	{
+		samples[sample] = samples[sample + index];
+	}
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+uint16_t _ds3231_sample_record_decode(const ds3231_sample_store_t *store, uint16_t offset, int64_t *delta_of_delta, int16_t *temperature_delta)
+{
+	int64_t values[2];
+
+	for (uint8_t value = 0; value < 2; value++)
+	{
+		uint64_t zigzag = 0;
+		uint8_t shift = 0;
+		uint8_t byte;
+
+		do
+		{
+			byte = store->buffer[offset];
+			zigzag |= (uint64_t)(byte & ~DS3231_VARINT_CONTINUE) << shift;
+			shift += 7;
+			offset = (uint16_t)((offset + 1) % DS3231_SAMPLE_STORE_SIZE);
+		} while (byte & DS3231_VARINT_CONTINUE);
+
+		values[value] = (zigzag & 1) ? -(int64_t)(zigzag >> 1) - 1 : (int64_t)(zigzag >> 1);
+	}
+
+	*delta_of_delta = values[0];
+	*temperature_delta = (int16_t)values[1];
+
+	return offset;
+}
+
+/********************************************************/
+/********************************************************/
+uint16_t _ds3231_sample_record_start(const ds3231_sample_store_t *store, uint16_t end)
+{
+	uint16_t offset = end;
+
+	/*Back over the last byte of each varint, then over the bytes before it that carry DS3231_VARINT_CONTINUE, never past the first record*/
+	for (uint8_t value = 0; value < 2; value++)
+	{
+		offset = (uint16_t)((offset + DS3231_SAMPLE_STORE_SIZE - 1) % DS3231_SAMPLE_STORE_SIZE);
+		while ((offset != store->head) && (store->buffer[(offset + DS3231_SAMPLE_STORE_SIZE - 1) % DS3231_SAMPLE_STORE_SIZE] & DS3231_VARINT_CONTINUE))
+		{
+			offset = (uint16_t)((offset + DS3231_SAMPLE_STORE_SIZE - 1) % DS3231_SAMPLE_STORE_SIZE);
+		}
+	}
+
+	return offset;
+}
+
+/********************************************************/
+/********************************************************/
+uint8_t _ds3231_varint_encode(const int64_t value, uint8_t *data)
+{
+	uint64_t zigzag = (value < 0) ? ~((uint64_t)value << 1) : (uint64_t)value << 1;
+	uint8_t length = 0;
+
+	while (zigzag >= DS3231_VARINT_CONTINUE)
+	{
+		data[length++] = (uint8_t)(zigzag | DS3231_VARINT_CONTINUE);
+		zigzag >>= 7;
+	}
+	data[length++] = (uint8_t)zigzag;
+
+	return length;
+}
+#endif
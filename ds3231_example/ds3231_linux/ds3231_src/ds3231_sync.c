@@ -0,0 +1,276 @@
+/**
+ * @file ds3231_sync.c
+ * @brief DS3231 Real Time Clock C Driver
+ * @author Reza G. Ebrahimi <https://github.com/ebrezadev>
+ * @version 2.0
+ * @license MIT
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Reza G. Ebrahimi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "ds3231.h"
+#include "ds3231_macros.h"
+
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_TIME_SYNC
+ds3231_error_code_t _ds3231_sync_timed_read(const ds3231_handle_t *handle, ds3231_reference_clock_fp reference_clock, uint8_t *data, const uint8_t number_of_bytes, int64_t *before_ns, int64_t *after_ns)
+{
+	DS3231_LOCK(handle);
+
+	*before_ns = reference_clock();
+	int result = handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_SECONDS, data, number_of_bytes);
+	*after_ns = reference_clock();
+
+	DS3231_UNLOCK(handle);
+
+	return (result != 0) ? DS3231_ERROR_INTERFACE_READ : DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t _ds3231_sync_wait_until(const ds3231_handle_t *handle, ds3231_reference_clock_fp reference_clock, const int64_t deadline_ns)
+{
+	int64_t sleep_ns = deadline_ns - reference_clock() - DS3231_SYNC_SPIN_NS;
+
+	if (sleep_ns > 0)
+	{
+		if (handle->interface.delay_function((uint32_t)(sleep_ns / 1000000)) != 0)
+		{
+			return DS3231_ERROR_INTERFACE_DELAY;
+		}
+	}
+
+	while (reference_clock() < deadline_ns)
+	{
+	}
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_set_time_aligned(const ds3231_handle_t *handle, const ds3231_epoch_t offset, ds3231_reference_clock_fp reference_clock, int64_t *alignment_error_ns)
+{
+	ds3231_error_code_t error;
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t data[DS3231_NUMBER_OF_TIME_REGISTERS];
+	int64_t latency_ns = INT64_MAX;
+	int64_t before_ns;
+	int64_t after_ns;
+
+	/*Measure the bus latency with reads of the same length as the write, the fastest one is the least disturbed*/
+	for (uint8_t probe = 0; probe < DS3231_SYNC_LATENCY_PROBES; probe++)
+	{
+		error = _ds3231_sync_timed_read(handle, reference_clock, data, DS3231_NUMBER_OF_TIME_REGISTERS, &before_ns, &after_ns);
+		DS3231_CHECK_AND_RETURN_ERROR(error);
+
+		latency_ns = ((after_ns - before_ns) < latency_ns) ? (after_ns - before_ns) : latency_ns;
+	}
+
+	/*Pick the next second boundary that leaves enough time to prepare*/
+	int64_t now_ns = reference_clock();
+	ds3231_epoch_t boundary = (ds3231_epoch_t)((now_ns >= 0) ? (now_ns / DS3231_NS_PER_SECOND) : ((now_ns - DS3231_NS_PER_SECOND + 1) / DS3231_NS_PER_SECOND)) + 1;
+
+	if ((boundary * DS3231_NS_PER_SECOND - now_ns) < (latency_ns + DS3231_SYNC_SPIN_NS))
+	{
+		boundary++;
+	}
+
+	ds3231_time_and_calendar_t time_struct;
+
+	error = ds3231_epoch_to_time_and_calendar(boundary + offset, &time_struct);
+	DS3231_CHECK_AND_RETURN_ERROR(error);
+	DS3231_TIME_STRUCT_RANGE_ERROR(handle, &time_struct);
+
+	_ds3231_time_block_from_time_and_calendar(&time_struct, data);
+
+	/*Start early by half the latency, so the middle of the write lands on the boundary*/
+	int64_t boundary_ns = boundary * DS3231_NS_PER_SECOND;
+
+	error = _ds3231_sync_wait_until(handle, reference_clock, boundary_ns - latency_ns / 2);
+	DS3231_CHECK_AND_RETURN_ERROR(error);
+
+	DS3231_LOCK(handle);
+
+	before_ns = reference_clock();
+	int result = handle->interface.write_array((uint8_t)handle->i2c_address, DS3231_REGISTER_SECONDS, data, DS3231_NUMBER_OF_TIME_REGISTERS);
+	after_ns = reference_clock();
+
+	DS3231_UNLOCK(handle);
+
+	if (result != 0)
+	{
+		return DS3231_ERROR_INTERFACE_WRITE;
+	}
+
+	*alignment_error_ns = before_ns + (after_ns - before_ns) / 2 - boundary_ns;
+
+	DS3231_VERIFY_BYTES(handle, error, DS3231_REGISTER_SECONDS, data, DS3231_NUMBER_OF_TIME_REGISTERS);
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_measure_phase(const ds3231_handle_t *handle, ds3231_reference_clock_fp reference_clock, const int64_t target_uncertainty_ns, ds3231_phase_t *phase)
+{
+	ds3231_error_code_t error;
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	uint8_t data[DS3231_NUMBER_OF_TIME_REGISTERS];
+	uint8_t first_second;
+	int64_t before_ns;
+	int64_t after_ns;
+	int64_t previous_before_ns;
+	int64_t latency_ns = INT64_MAX;
+	uint16_t transactions = 0;
+
+	/*Coarse: poll the seconds register every few milliseconds until it changes*/
+	error = _ds3231_sync_timed_read(handle, reference_clock, &first_second, 1, &previous_before_ns, &after_ns);
+	DS3231_CHECK_AND_RETURN_ERROR(error);
+	transactions++;
+
+	int64_t start_ns = previous_before_ns;
+
+	for (;;)
+	{
+		latency_ns = ((after_ns - previous_before_ns) < latency_ns) ? (after_ns - previous_before_ns) : latency_ns;
+
+		if ((after_ns - start_ns) > DS3231_SYNC_EDGE_TIMEOUT_NS)
+		{
+			return DS3231_ERROR_SYNC_EDGE_TIMEOUT;
+		}
+
+		if (handle->interface.delay_function(DS3231_SYNC_COARSE_STEP_MS) != 0)
+		{
+			return DS3231_ERROR_INTERFACE_DELAY;
+		}
+
+		error = _ds3231_sync_timed_read(handle, reference_clock, data, 1, &before_ns, &after_ns);
+		DS3231_CHECK_AND_RETURN_ERROR(error);
+		transactions++;
+
+		if (data[DS3231_SECONDS] != first_second)
+		{
+			break;
+		}
+
+		previous_before_ns = before_ns;
+	}
+
+	latency_ns = ((after_ns - before_ns) < latency_ns) ? (after_ns - before_ns) : latency_ns;
+
+	/*The register was sampled somewhere inside each transaction, so the edge is after the start of the last old read and before the end of the first new one*/
+	int64_t low_ns = previous_before_ns;
+	int64_t high_ns = after_ns;
+
+	/*The rest of the second is left, read the whole time block to know which second started*/
+	error = _ds3231_sync_timed_read(handle, reference_clock, data, DS3231_NUMBER_OF_TIME_REGISTERS, &before_ns, &after_ns);
+	DS3231_CHECK_AND_RETURN_ERROR(error);
+	transactions++;
+
+	ds3231_epoch_t edge_epoch = _ds3231_epoch_from_time_block(data);
+	uint8_t edge_second = data[DS3231_SECONDS];
+
+	/*Fine: each pass splits the bound in parts and probes their limits in order, projected onto a later second, up to the first read of the new second*/
+	int64_t seconds_later = 0;
+
+	for (uint8_t pass = 0; pass < DS3231_SYNC_MAX_PASSES; pass++)
+	{
+		if (((high_ns - low_ns) / 2 <= target_uncertainty_ns) || ((high_ns - low_ns) <= 2 * latency_ns))
+		{
+			break;
+		}
+
+		/*Probes closer than two latencies would overlap*/
+		int64_t step_ns = (high_ns - low_ns) / DS3231_SYNC_PARTS_PER_PASS;
+		step_ns = (step_ns < 2 * latency_ns) ? 2 * latency_ns : step_ns;
+
+		int64_t pass_low_ns = low_ns;
+		int64_t pass_high_ns = high_ns;
+		int64_t earliest_ns = reference_clock() + DS3231_SYNC_SPIN_NS + latency_ns;
+		int64_t later = (earliest_ns - (pass_low_ns + step_ns) + DS3231_NS_PER_SECOND - 1) / DS3231_NS_PER_SECOND;
+
+		/*Compare with the second expected before and after the projected edge*/
+		uint8_t expected_after = edge_second;
+		for (int64_t count = 0; count < later; count++)
+		{
+			expected_after = _ds3231_bcd_increment_second(expected_after);
+		}
+
+		for (int64_t probe_ns = pass_low_ns + step_ns; probe_ns < pass_high_ns; probe_ns += step_ns)
+		{
+			error = _ds3231_sync_wait_until(handle, reference_clock, probe_ns + later * DS3231_NS_PER_SECOND - latency_ns / 2);
+			DS3231_CHECK_AND_RETURN_ERROR(error);
+
+			uint8_t second;
+			error = _ds3231_sync_timed_read(handle, reference_clock, &second, 1, &before_ns, &after_ns);
+			DS3231_CHECK_AND_RETURN_ERROR(error);
+			transactions++;
+
+			if (second == expected_after)
+			{
+				high_ns = ((after_ns - later * DS3231_NS_PER_SECOND) < high_ns) ? (after_ns - later * DS3231_NS_PER_SECOND) : high_ns;
+				break;
+			}
+			else if (_ds3231_bcd_increment_second(second) == expected_after)
+			{
+				low_ns = ((before_ns - later * DS3231_NS_PER_SECOND) > low_ns) ? (before_ns - later * DS3231_NS_PER_SECOND) : low_ns;
+			}
+			else
+			{
+				/*The time was changed meanwhile*/
+				return DS3231_ERROR_SYNC_INCONSISTENT;
+			}
+		}
+
+		seconds_later = later;
+	}
+
+	/*Report the latest edge that was probed*/
+	phase->rtc_epoch = edge_epoch + seconds_later;
+	phase->edge_ns = low_ns + (high_ns - low_ns) / 2 + seconds_later * DS3231_NS_PER_SECOND;
+	phase->offset_ns = phase->rtc_epoch * DS3231_NS_PER_SECOND - phase->edge_ns;
+	phase->uncertainty_ns = (high_ns - low_ns + 1) / 2;
+	phase->transactions = transactions;
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+uint8_t _ds3231_bcd_increment_second(const uint8_t second)
+{
+	/*BCD seconds, 0x59 rolls over to 0x00 and x9 carries into the tens*/
+	if (second == 0x59)
+	{
+		return 0x00;
+	}
+
+	return ((second & 0x0f) == 0x09) ? (uint8_t)((second & 0xf0) + 0x10) : (uint8_t)(second + 1);
+}
+#endif
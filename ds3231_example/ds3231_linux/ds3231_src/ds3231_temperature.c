@@ -34,8 +34,7 @@
 /********************************************************/
 /********************************************************/
 #if DS3231_INCLUDE_TEMPERATURE
-#if DS3231_INCLUDE_TEMPERATURE_FLOAT_MATH
-ds3231_error_code_t ds3231_get_temperature(const ds3231_handle_t *handle, float *temperature)
+ds3231_error_code_t ds3231_get_temperature_raw(const ds3231_handle_t *handle, int16_t *raw)
 {
 	ds3231_error_code_t error;
 	DS3231_NULL_CHECK_MACRO(handle, error);
@@ -96,98 +95,39 @@ ds3231_error_code_t ds3231_get_temperature(const ds3231_handle_t *handle, float
 	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_TEMP_MSB, data, 2) != 0)
 	{
 		DS3231_UNLOCK(handle);
-		return DS3231_ERROR_INTERFACE_WRITE;
+		return DS3231_ERROR_INTERFACE_READ;
 	}
 	DS3231_UNLOCK(handle);
 
-	/*Extract the float temperature based on data*/
-	float sign_bit = 1;
-	if ((data[0] >> 7) == 1)
-	{
-		sign_bit = -1;
-	}
-
-	*temperature = (float)((int8_t)data[0]) + (float)(sign_bit * ((float)0.25 * (data[1] >> 6)));
+	*raw = _ds3231_temperature_raw(data);
 
 	return DS3231_ERROR_OK;
 }
 
-#else
+#if DS3231_INCLUDE_TEMPERATURE_FLOAT_MATH
 /********************************************************/
 /********************************************************/
-ds3231_error_code_t ds3231_get_temperature(const ds3231_handle_t *handle, int16_t *temperature)
+ds3231_error_code_t ds3231_get_temperature(const ds3231_handle_t *handle, float *temperature)
 {
-	ds3231_error_code_t error;
-	DS3231_NULL_CHECK_MACRO(handle, error);
-	DS3231_CONNECTION_CHECK(handle);
-
-	/*Check the BSY bit*/
-	ds3231_bool_t bit = DS3231_TRUE;
-	uint32_t timeout = DS3231_TEMPERATURE_READ_TIMEOUT;
-
-	for (; bit == DS3231_TRUE;)
-	{
-		if (timeout > DS3231_TEMPERATURE_READ_DELAY)
-		{
-			timeout -= DS3231_TEMPERATURE_READ_DELAY;
-		}
-		else
-		{
-			return DS3231_ERROR_TEMPERATURE_BUSY_TIMEOUT;
-		}
-
-		handle->interface.delay_function(DS3231_TEMPERATURE_READ_DELAY);
-
-		error = _ds3231_bit_get(handle, DS3231_REGISTER_CONTROL_STATUS, DS3231_BIT_BSY, &bit);
-		DS3231_CHECK_AND_RETURN_ERROR(error);
-	}
-
-	/*Set the CONV bit to start conversion of temperature to digital*/
-	error = _ds3231_bit_set(handle, DS3231_REGISTER_CONTROL, DS3231_BIT_CONV, DS3231_TRUE);
+	int16_t raw;
+	ds3231_error_code_t error = ds3231_get_temperature_raw(handle, &raw);
 	DS3231_CHECK_AND_RETURN_ERROR(error);
 
-	DS3231_VERIFY_BIT(handle, error, DS3231_REGISTER_CONTROL, DS3231_BIT_CONV, DS3231_TRUE);
+	*temperature = ds3231_temperature_raw_to_float(raw);
 
-	/*Check the CONV bit*/
-	bit = DS3231_TRUE;
-	timeout = DS3231_TEMPERATURE_READ_TIMEOUT;
-
-	for (; bit == DS3231_TRUE;)
-	{
-		if (timeout > DS3231_TEMPERATURE_READ_DELAY)
-		{
-			timeout -= DS3231_TEMPERATURE_READ_DELAY;
-		}
-		else
-		{
-			return DS3231_ERROR_TEMPERATURE_CONVERSION_TIMEOUT;
-		}
-
-		handle->interface.delay_function(DS3231_TEMPERATURE_READ_DELAY);
-
-		error = _ds3231_bit_get(handle, DS3231_REGISTER_CONTROL_STATUS, DS3231_BIT_BSY, &bit);
-		DS3231_CHECK_AND_RETURN_ERROR(error);
-	}
-
-	/*Read the MSB and LSB bytes. data[0] is MSB, data[1] is LSB*/
-	uint8_t data[2];
-
-	DS3231_LOCK(handle);
-	if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_TEMP_MSB, data, 2) != 0)
-	{
-		DS3231_UNLOCK(handle);
-		return DS3231_ERROR_INTERFACE_WRITE;
-	}
-	DS3231_UNLOCK(handle);
+	return DS3231_ERROR_OK;
+}
 
-	/*Extract the float temperature based on data*/
-	int16_t sign_bit = 1;
-	if ((data[0] >> 7) == 1)
-	{
-		sign_bit = -1;
-	}
+#else
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_get_temperature(const ds3231_handle_t *handle, int16_t *temperature)
+{
+	int16_t raw;
+	ds3231_error_code_t error = ds3231_get_temperature_raw(handle, &raw);
+	DS3231_CHECK_AND_RETURN_ERROR(error);
 
-	*temperature = ((int16_t)data[0] * 100) + sign_bit * 25 * (int16_t)((uint8_t)(data[1] >> 6));
+	*temperature = ds3231_temperature_raw_to_centi(raw);
 
 	return DS3231_ERROR_OK;
 }
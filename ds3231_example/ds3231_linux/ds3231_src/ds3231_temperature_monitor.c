@@ -0,0 +1,157 @@
+/**
+ * @file ds3231_temperature_monitor.c
+ * @brief DS3231 Real Time Clock C Driver
+ * @author Reza G. Ebrahimi <https://github.com/ebrezadev>
+ * @version 2.0
+ * @license MIT
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Reza G. Ebrahimi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "ds3231.h"
+#include "ds3231_macros.h"
+
+
+/********************************************************/
+/********************************************************/
+#if DS3231_INCLUDE_TEMPERATURE_MONITOR
+void ds3231_temperature_monitor_init(ds3231_temperature_monitor_t *monitor, ds3231_temperature_event_fp callback, void *context)
+{
+	monitor->high = INT16_MAX;
+	monitor->low = INT16_MIN;
+	monitor->hysteresis = DS3231_TEMPERATURE_MONITOR_HYSTERESIS;
+	monitor->rate_limit = 0;
+	monitor->callback = callback;
+	monitor->context = context;
+	monitor->temperature = 0;
+	monitor->rate = 0;
+	monitor->reference = 0;
+	monitor->reference_at = DS3231_TEMPERATURE_NOT_SAMPLED;
+	monitor->interval = DS3231_TEMPERATURE_MONITOR_MAX_INTERVAL_S;
+	monitor->active = 0;
+}
+
+/********************************************************/
+/********************************************************/
+ds3231_error_code_t ds3231_temperature_monitor_sample(const ds3231_handle_t *handle, ds3231_temperature_monitor_t *monitor, const ds3231_epoch_t now, uint32_t *interval)
+{
+	ds3231_error_code_t error;
+	DS3231_NULL_CHECK_MACRO(handle, error);
+	DS3231_CONNECTION_CHECK(handle);
+
+	int16_t temperature;
+
+	/*The last conversion of DS3231 is at most 64 seconds old, fresh enough for the longest interval only*/
+	if (monitor->interval < DS3231_TEMPERATURE_MONITOR_MAX_INTERVAL_S)
+	{
+		error = ds3231_get_temperature_raw(handle, &temperature);
+		DS3231_CHECK_AND_RETURN_ERROR(error);
+	}
+	else
+	{
+		uint8_t data[2];
+
+		DS3231_LOCK(handle);
+		if (handle->interface.read_array((uint8_t)handle->i2c_address, DS3231_REGISTER_TEMP_MSB, data, 2) != 0)
+		{
+			DS3231_UNLOCK(handle);
+			return DS3231_ERROR_INTERFACE_READ;
+		}
+		DS3231_UNLOCK(handle);
+
+		temperature = _ds3231_temperature_raw(data);
+	}
+
+	/*The rate is measured from the reference sample once the change or the time since is enough to tell it from the noise, the first sample is only a reference*/
+	int16_t step = (int16_t)((temperature > monitor->reference) ? temperature - monitor->reference : monitor->reference - temperature);
+	ds3231_bool_t measured = (ds3231_bool_t)((monitor->reference_at != DS3231_TEMPERATURE_NOT_SAMPLED) && (now > monitor->reference_at) &&
+											 ((step >= DS3231_TEMPERATURE_MONITOR_MIN_STEP) || (now - monitor->reference_at >= DS3231_TEMPERATURE_MONITOR_MAX_INTERVAL_S)));
+
+	if (measured == DS3231_TRUE)
+	{
+		monitor->rate = (int32_t)(((int32_t)temperature - monitor->reference) * DS3231_TEMPERATURE_MONITOR_RATE_PERIOD_S / (now - monitor->reference_at));
+	}
+	if ((measured == DS3231_TRUE) || (monitor->reference_at == DS3231_TEMPERATURE_NOT_SAMPLED) || (now <= monitor->reference_at))
+	{
+		monitor->reference = temperature;
+		monitor->reference_at = now;
+	}
+	monitor->temperature = temperature;
+
+	int32_t rate = (monitor->rate < 0) ? -monitor->rate : monitor->rate;
+
+	_ds3231_temperature_monitor_event(monitor, DS3231_TEMPERATURE_EVENT_HIGH, (ds3231_bool_t)(temperature >= monitor->high),
+									  (ds3231_bool_t)(temperature <= monitor->high - monitor->hysteresis));
+	_ds3231_temperature_monitor_event(monitor, DS3231_TEMPERATURE_EVENT_LOW, (ds3231_bool_t)(temperature <= monitor->low),
+									  (ds3231_bool_t)(temperature >= monitor->low + monitor->hysteresis));
+	if ((monitor->rate_limit > 0) && (measured == DS3231_TRUE))
+	{
+		_ds3231_temperature_monitor_event(monitor, DS3231_TEMPERATURE_EVENT_RATE, (ds3231_bool_t)(rate >= monitor->rate_limit), (ds3231_bool_t)(2 * rate < monitor->rate_limit));
+	}
+
+	/*Half the rate limit counts as changing, so the samples are already dense when the limit is reached. A change too small to measure lengthens the interval*/
+	int32_t changing = (monitor->rate_limit > 0) ? (monitor->rate_limit + 1) / 2 : DS3231_TEMPERATURE_MONITOR_CHANGING_RATE;
+
+	if ((measured == DS3231_TRUE) && (rate >= changing))
+	{
+		monitor->interval = (monitor->interval / 2 > DS3231_TEMPERATURE_MONITOR_MIN_INTERVAL_S) ? monitor->interval / 2 : DS3231_TEMPERATURE_MONITOR_MIN_INTERVAL_S;
+	}
+	else
+	{
+		monitor->interval = (monitor->interval * 2 < DS3231_TEMPERATURE_MONITOR_MAX_INTERVAL_S) ? monitor->interval * 2 : DS3231_TEMPERATURE_MONITOR_MAX_INTERVAL_S;
+	}
+
+	*interval = monitor->interval;
+
+	return DS3231_ERROR_OK;
+}
+
+/********************************************************/
+/********************************************************/
+void _ds3231_temperature_monitor_event(ds3231_temperature_monitor_t *monitor, const ds3231_temperature_event_t event, const ds3231_bool_t enter, const ds3231_bool_t leave)
+{
+	uint8_t bit = (uint8_t)(1 << event);
+	ds3231_bool_t active;
+
+	if (((monitor->active & bit) == 0) && (enter == DS3231_TRUE))
+	{
+		monitor->active |= bit;
+		active = DS3231_TRUE;
+	}
+	else if (((monitor->active & bit) != 0) && (leave == DS3231_TRUE))
+	{
+		monitor->active &= (uint8_t)(~bit);
+		active = DS3231_FALSE;
+	}
+	else
+	{
+		return;
+	}
+
+	if (monitor->callback != NULL)
+	{
+		monitor->callback(monitor->context, event, active, monitor->temperature);
+	}
+}
+
+#endif
@@ -1,97 +1,309 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include "ds3231.h"
 #include "interface.h"
+#include "mock_interface.h"
 
 ds3231_handle_t handle;
-ds3231_error_code_t error;
-ds3231_time_and_calendar_t time_struct;
 char *log_message;
 
 const char *month[] = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN", "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
 const char *day[] = {"MON", "TUE", "WED", "THU", "FRI", "SAT", "SUN"};
 
-#define PRINT_ERROR(str, error)                         \
-	do                                                  \
-	{                                                   \
-		ds3231_error_string(error, &log_message);       \
-		printf("%s %s\n", str, log_message); \
+/*Default file to persist the drift history between runs*/
+static const char *default_drift_file = "ds3231_drift.bin";
+
+/*Default uncertainty of the seconds edge, a few seconds of probing instead of the best the bus allows*/
+static const int64_t default_uncertainty_us = 1000;
+
+#define NS_PER_SECOND 1000000000LL
+
+#define PRINT_ERROR(str, error)                           \
+	do                                                    \
+	{                                                     \
+		ds3231_error_string(error, &log_message);         \
+		fprintf(stderr, "%s %s\n", str, log_message);     \
 	} while (0)
 
-int main()
+static int64_t clock_ns(clockid_t clock)
+{
+	struct timespec now;
+	clock_gettime(clock, &now);
+
+	return (int64_t)now.tv_sec * NS_PER_SECOND + now.tv_nsec;
+}
+
+static int64_t realtime_ns(void)
+{
+	return clock_ns(CLOCK_REALTIME);
+}
+
+static int64_t monotonic_ns(void)
+{
+	return clock_ns(CLOCK_MONOTONIC);
+}
+
+static void print_epoch(const char *label, ds3231_epoch_t epoch, int64_t fraction_ns)
+{
+	ds3231_time_and_calendar_t time_struct;
+	ds3231_epoch_to_time_and_calendar(epoch, &time_struct);
+
+	printf("%s%s %04d-%s-%02d %02d:%02d:%02d.%03d UTC\n", label, day[time_struct.day - 1], time_struct.year, month[time_struct.month - 1], time_struct.date,
+		   time_struct.hour, time_struct.minute, time_struct.second, (int)(fraction_ns / 1000000));
+}
+
+static int command_show(void)
+{
+	ds3231_time_and_calendar_t time_struct;
+	ds3231_epoch_t epoch;
+
+	ds3231_error_code_t error = ds3231_get_all_time_and_calendar(&handle, &time_struct);
+	if (error != DS3231_ERROR_OK)
+	{
+		PRINT_ERROR("READ ERR:", error);
+		return 1;
+	}
+
+	ds3231_time_and_calendar_to_epoch(&time_struct, &epoch);
+	print_epoch("", epoch, 0);
+
+	return 0;
+}
+
+static int command_hctosys(int64_t uncertainty_us)
 {
-	printf("HELLO\n");
-	handle.interface.delay_function = ds3231_delay_function;
-	handle.interface.interface_deinit = ds3231_interface_deinit;
-	handle.interface.interface_init = ds3231_interface_init;
-	handle.interface.read_array = ds3231_read_array;
-	handle.interface.write_array = ds3231_write_array;
-	handle.interface.interface_ack_test = ds3231_interface_ack_test;
+	ds3231_phase_t phase;
 
-	error = ds3231_init(&handle);
-	PRINT_ERROR("INIT ERR:", error);
-	
-	if (error == DS3231_ERROR_DS3231_NOT_CONNECTED)
+	/*Find the edge on the monotonic clock, it doesn't move when the system time is set*/
+	ds3231_error_code_t error = ds3231_measure_phase(&handle, monotonic_ns, uncertainty_us * 1000, &phase);
+	if (error != DS3231_ERROR_OK)
 	{
-		PRINT_ERROR("DS3231 NOT CONNECTED", error);
-		for (;;)
-			;
+		PRINT_ERROR("PHASE ERR:", error);
+		return 1;
 	}
 
-	error = ds3231_reset_all(&handle);
-	PRINT_ERROR("RESET ERR: ", error);
+	int64_t system_before_ns = realtime_ns();
+	int64_t target_ns = phase.rtc_epoch * NS_PER_SECOND + (monotonic_ns() - phase.edge_ns);
+	struct timespec target = {(time_t)(target_ns / NS_PER_SECOND), (long)(target_ns % NS_PER_SECOND)};
 
-	error = ds3231_set_hour(&handle, 15);
-	PRINT_ERROR("SET ERR: ", error);
+	if (clock_settime(CLOCK_REALTIME, &target) != 0)
+	{
+		perror("ERROR IN SETTING SYSTEM TIME");
+		return 1;
+	}
+
+	print_epoch("SYSTEM TIME SET TO ", (ds3231_epoch_t)(target_ns / NS_PER_SECOND), target_ns % NS_PER_SECOND);
+	printf("STEP %+.3f ms, UNCERTAINTY %.3f ms\n", (double)(target_ns - system_before_ns) / 1e6, (double)phase.uncertainty_ns / 1e6);
+
+	return 0;
+}
+
+static int command_systohc(void)
+{
+	int64_t alignment_error_ns;
+
+	ds3231_error_code_t error = ds3231_set_time_aligned(&handle, 0, realtime_ns, &alignment_error_ns);
+	if (error != DS3231_ERROR_OK)
+	{
+		PRINT_ERROR("SET ERR:", error);
+		return 1;
+	}
+
+	printf("RTC SET, ALIGNMENT ERROR %+.3f ms\n", (double)alignment_error_ns / 1e6);
+
+	return 0;
+}
 
-	time_struct.year = 1999;
-	time_struct.month = DS3231_MONTH_DECEMBER;
-	time_struct.day = DS3231_DAY_MONDAY;
-	time_struct.date = 31;
-	time_struct.minute = 59;
-	time_struct.hour = 23;
-	time_struct.second = 50;
+static int command_compare(int count, int64_t uncertainty_us)
+{
+	int64_t sum_ns = 0;
 
-	error = ds3231_set_all_time_and_calendar(&handle, &time_struct);
-	PRINT_ERROR("SET ALL ERR: ", error);
+	for (int index = 0; index < count; index++)
+	{
+		ds3231_phase_t phase;
 
-	error = ds3231_32khz_wave_control(&handle, DS3231_TRUE);
-	PRINT_ERROR("32K ERR: ", error);
+		ds3231_error_code_t error = ds3231_measure_phase(&handle, realtime_ns, uncertainty_us * 1000, &phase);
+		if (error != DS3231_ERROR_OK)
+		{
+			PRINT_ERROR("PHASE ERR:", error);
+			return 1;
+		}
 
-	error = ds3231_int_sqw_pin_select(&handle, DS3231_PIN_SQUAREWAVE);
-	PRINT_ERROR("SQW ERR: ", error);
+		sum_ns += phase.offset_ns;
 
-	error = ds3231_sqw_output_wave_frequency(&handle, DS3231_SQW_WAVE_1024HZ);
-	PRINT_ERROR("SQW FREQ ERR: ", error);
+		print_epoch("", phase.rtc_epoch, 0);
+		printf("RTC - SYSTEM %+.3f ms +/- %.3f ms, %d TRANSACTIONS\n", (double)phase.offset_ns / 1e6, (double)phase.uncertainty_ns / 1e6, phase.transactions);
+	}
 
-	error = ds3231_int_sqw_pin_select(&handle, DS3231_PIN_INTERRUPT);
-	PRINT_ERROR("INTPIN ERR: ", error);
+	printf("MEAN %+.3f ms\n", (double)sum_ns / count / 1e6);
 
-	for (;;)
+	return 0;
+}
+
+static int command_drift_report(const char *path, int apply)
+{
+	ds3231_drift_t drift;
+	ds3231_error_code_t error;
+	FILE *file = fopen(path, "rb");
+
+	if ((file == NULL) || (fread(&drift, sizeof(drift), 1, file) != 1))
 	{
-		error = ds3231_get_all_time_and_calendar(&handle, &time_struct);
-		// PRINT_ERROR("GETALL ERR: ", error);
-		if (error == DS3231_ERROR_DS3231_NOT_CONNECTED)
+		printf("NEW DRIFT HISTORY IN %s\n", path);
+		error = ds3231_drift_init(&handle, &drift);
+		if (error != DS3231_ERROR_OK)
 		{
-			PRINT_ERROR("DS3231 NOT CONNECTED ", error);
-			for (;;)
-				;
+			PRINT_ERROR("INIT ERR:", error);
+			return 1;
 		}
+	}
+	if (file != NULL)
+	{
+		fclose(file);
+	}
 
-		printf("%d %d %d %d %d %d %d\n", time_struct.year, time_struct.month, time_struct.date, time_struct.day, time_struct.hour, time_struct.minute, time_struct.second);
-		float temperature;
-		error = ds3231_get_temperature(&handle, &temperature);
-		PRINT_ERROR("TEMP ERR: ", error);
-		if (error == DS3231_ERROR_DS3231_NOT_CONNECTED)
+	if (apply)
+	{
+		ds3231_bool_t applied;
+		error = ds3231_drift_update(&handle, &drift, realtime_ns, &applied);
+		if ((error == DS3231_ERROR_OK) && (applied == DS3231_TRUE))
 		{
-			PRINT_ERROR("CONNECTION ERROR", error);
-			for (;;)
-				;
+			printf("AGING OFFSET SET TO %d\n", drift.aging_offset);
 		}
+	}
+	else
+	{
+		error = ds3231_drift_sample(&handle, &drift, realtime_ns);
+	}
+	if (error != DS3231_ERROR_OK)
+	{
+		PRINT_ERROR("SAMPLE ERR:", error);
+		return 1;
+	}
+
+	file = fopen(path, "wb");
+	if ((file == NULL) || (fwrite(&drift, sizeof(drift), 1, file) != 1))
+	{
+		perror("ERROR IN SAVING DRIFT HISTORY");
+		return 1;
+	}
+	fclose(file);
+
+	const ds3231_drift_sample_t *last = &drift.samples[(drift.next_sample + DS3231_DRIFT_HISTORY_LENGTH - 1) % DS3231_DRIFT_HISTORY_LENGTH];
+	printf("SAMPLES %d, AGING OFFSET %d, RTC - SYSTEM %+.3f ms\n", drift.sample_count, drift.aging_offset, (double)(last->rtc_epoch * NS_PER_SECOND - last->reference_ns) / 1e6);
 
-		printf("%f\n", temperature);
-		// ds3231_alarm_1_flag_clear(&handle);
-		sleep(1);
+	int32_t drift_ppb;
+	error = ds3231_drift_estimate(&drift, &drift_ppb);
+	if (error == DS3231_ERROR_DRIFT_NOT_ENOUGH_SAMPLES)
+	{
+		printf("DRIFT NOT KNOWN YET, TAKE SAMPLES AT LEAST %u s APART\n", (unsigned)DS3231_DRIFT_MIN_PAIR_INTERVAL_S);
+		return 0;
 	}
 
+	printf("DRIFT %+.3f ppm, %+.2f s PER MONTH\n", drift_ppb / 1000.0, drift_ppb * 1e-9 * 30 * 86400);
+
 	return 0;
 }
+
+static void usage(const char *name)
+{
+	fprintf(stderr, "usage: %s [-m] COMMAND\n"
+					"  -m                    use the simulated DS3231 instead of I2C_DEV_PATH (or DS3231_BACKEND=mock)\n"
+					"commands:\n"
+					"  show                  print the RTC time\n"
+					"  hctosys [US]          set the system time from the RTC, on its seconds edge found within US microseconds (default %lld)\n"
+					"  systohc               set the RTC from the system time, on a second boundary\n"
+					"  compare [COUNT [US]]  measure the RTC - system offset on COUNT edges (default 5), each found within US microseconds (default %lld)\n"
+					"  drift-report [-a] [FILE]\n"
+					"                        sample the drift into FILE (default %s), -a applies the aging offset\n",
+			name, (long long)default_uncertainty_us, (long long)default_uncertainty_us, default_drift_file);
+}
+
+int main(int argc, char **argv)
+{
+	int argument = 1;
+	const char *backend = getenv("DS3231_BACKEND");
+	int use_mock = (backend != NULL) && (strcmp(backend, "mock") == 0);
+
+	if ((argument < argc) && (strcmp(argv[argument], "-m") == 0))
+	{
+		use_mock = 1;
+		argument++;
+	}
+
+	if (argument >= argc)
+	{
+		usage(argv[0]);
+		return 2;
+	}
+
+	const char *command = argv[argument++];
+
+	memset(&handle, 0, sizeof(handle));
+	if (use_mock)
+	{
+		handle.interface.delay_function = ds3231_mock_delay_function;
+		handle.interface.interface_deinit = ds3231_mock_interface_deinit;
+		handle.interface.interface_init = ds3231_mock_interface_init;
+		handle.interface.read_array = ds3231_mock_read_array;
+		handle.interface.write_array = ds3231_mock_write_array;
+		handle.interface.interface_ack_test = ds3231_mock_interface_ack_test;
+	}
+	else
+	{
+		handle.interface.delay_function = ds3231_delay_function;
+		handle.interface.interface_deinit = ds3231_interface_deinit;
+		handle.interface.interface_init = ds3231_interface_init;
+		handle.interface.read_array = ds3231_read_array;
+		handle.interface.write_array = ds3231_write_array;
+		handle.interface.interface_ack_test = ds3231_interface_ack_test;
+	}
+
+	ds3231_error_code_t error = ds3231_init(&handle);
+	if (error != DS3231_ERROR_OK)
+	{
+		PRINT_ERROR("INIT ERR:", error);
+		return 1;
+	}
+
+	/*The checks are done once by ds3231_init, the timing critical paths run lean*/
+	handle.policy = DS3231_POLICY_LEAN;
+
+	int result;
+
+	if (strcmp(command, "show") == 0)
+	{
+		result = command_show();
+	}
+	else if (strcmp(command, "hctosys") == 0)
+	{
+		int64_t uncertainty_us = (argument < argc) ? atoll(argv[argument]) : default_uncertainty_us;
+		result = command_hctosys((uncertainty_us >= 0) ? uncertainty_us : default_uncertainty_us);
+	}
+	else if (strcmp(command, "systohc") == 0)
+	{
+		result = command_systohc();
+	}
+	else if (strcmp(command, "compare") == 0)
+	{
+		int count = (argument < argc) ? atoi(argv[argument++]) : 5;
+		int64_t uncertainty_us = (argument < argc) ? atoll(argv[argument]) : default_uncertainty_us;
+		result = command_compare((count > 0) ? count : 5, (uncertainty_us >= 0) ? uncertainty_us : default_uncertainty_us);
+	}
+	else if (strcmp(command, "drift-report") == 0)
+	{
+		int apply = (argument < argc) && (strcmp(argv[argument], "-a") == 0);
+		argument += apply;
+		result = command_drift_report((argument < argc) ? argv[argument] : default_drift_file, apply);
+	}
+	else
+	{
+		usage(argv[0]);
+		result = 2;
+	}
+
+	ds3231_deinit(&handle);
+
+	return result;
+}
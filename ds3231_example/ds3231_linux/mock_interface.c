@@ -0,0 +1,256 @@
+#include "mock_interface.h"
+
+#define MOCK_NUMBER_OF_REGISTERS 19
+
+static uint8_t mock_registers[MOCK_NUMBER_OF_REGISTERS];
+static double mock_ppm;
+/*The simulated time is mock_base_ns at mock_base_monotonic_ns, and runs at the drifted rate since*/
+static int64_t mock_base_ns;
+static int64_t mock_base_monotonic_ns;
+/*The alarms are matched on every second up to this one*/
+static ds3231_epoch_t mock_alarm_checked;
+static uint32_t mock_bus_bytes;
+
+static int64_t mock_clock_ns(clockid_t clock)
+{
+	struct timespec now;
+	clock_gettime(clock, &now);
+
+	return (int64_t)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+/*The drift of the simulated crystal, the aging offset slows it down by 0.1 ppm per LSB*/
+static double mock_effective_ppm(void)
+{
+	return mock_ppm - 0.1 * (int8_t)mock_registers[DS3231_REGISTER_AGING_OFFSET];
+}
+
+static int64_t mock_now_ns(void)
+{
+	int64_t elapsed_ns = mock_clock_ns(CLOCK_MONOTONIC) - mock_base_monotonic_ns;
+
+	return mock_base_ns + elapsed_ns + (int64_t)((double)elapsed_ns * mock_effective_ppm() * 1e-6);
+}
+
+static void mock_rebase(int64_t now_ns)
+{
+	mock_base_ns = now_ns;
+	mock_base_monotonic_ns = mock_clock_ns(CLOCK_MONOTONIC);
+}
+
+static ds3231_epoch_t mock_now_epoch(void)
+{
+	int64_t now_ns = mock_now_ns();
+
+	return (now_ns >= 0) ? (now_ns / 1000000000LL) : ((now_ns - 999999999LL) / 1000000000LL);
+}
+
+/*An alarm register matches when its mask bit is set or its value is the time register value*/
+static int mock_alarm_field_matches(uint8_t alarm, uint8_t time, uint8_t value_mask)
+{
+	return ((alarm & (1 << DS3231_BIT_A1M4)) != 0) || ((alarm & value_mask) == (time & value_mask));
+}
+
+static int mock_alarm_day_date_matches(uint8_t alarm, const uint8_t *time_block)
+{
+	if ((alarm & (1 << DS3231_BIT_A1M4)) != 0)
+	{
+		return 1;
+	}
+	if ((alarm & (1 << DS3231_BIT_DY_DT_ALARM1)) != 0)
+	{
+		return (alarm & 0x0F) == time_block[DS3231_REGISTER_DAY_OF_WEEK];
+	}
+
+	return (alarm & 0x3F) == time_block[DS3231_REGISTER_DATE];
+}
+
+/*Fills the time registers from the simulated time, and sets the flags of the alarms that matched meanwhile*/
+static void mock_time_to_registers(void)
+{
+	ds3231_time_and_calendar_t time_struct;
+	ds3231_epoch_t epoch = mock_now_epoch();
+
+	/*A step of the time doesn't fire the alarms in between*/
+	if ((epoch < mock_alarm_checked) || ((epoch - mock_alarm_checked) > 86400))
+	{
+		mock_alarm_checked = epoch;
+	}
+
+	while (mock_alarm_checked < epoch)
+	{
+		mock_alarm_checked++;
+		ds3231_epoch_to_time_and_calendar(mock_alarm_checked, &time_struct);
+		_ds3231_time_block_from_time_and_calendar(&time_struct, mock_registers);
+
+		if (mock_alarm_field_matches(mock_registers[DS3231_REGISTER_ALARM1_SECONDS], mock_registers[DS3231_REGISTER_SECONDS], 0x7F) &&
+			mock_alarm_field_matches(mock_registers[DS3231_REGISTER_ALARM1_MINUTES], mock_registers[DS3231_REGISTER_MINUTES], 0x7F) &&
+			mock_alarm_field_matches(mock_registers[DS3231_REGISTER_ALARM1_HOURS], mock_registers[DS3231_REGISTER_HOURS], 0x3F) &&
+			mock_alarm_day_date_matches(mock_registers[DS3231_REGISTER_ALARM1_DAY_OF_WEEK_OR_DATE], mock_registers))
+		{
+			mock_registers[DS3231_REGISTER_CONTROL_STATUS] |= (1 << DS3231_BIT_A1F);
+		}
+
+		/*Alarm 2 matches at second 00*/
+		if ((mock_registers[DS3231_REGISTER_SECONDS] == 0) &&
+			mock_alarm_field_matches(mock_registers[DS3231_REGISTER_ALARM2_MINUTES], mock_registers[DS3231_REGISTER_MINUTES], 0x7F) &&
+			mock_alarm_field_matches(mock_registers[DS3231_REGISTER_ALARM2_HOURS], mock_registers[DS3231_REGISTER_HOURS], 0x3F) &&
+			mock_alarm_day_date_matches(mock_registers[DS3231_REGISTER_ALARM2_DAY_OF_WEEK_OR_DATE], mock_registers))
+		{
+			mock_registers[DS3231_REGISTER_CONTROL_STATUS] |= (1 << DS3231_BIT_A2F);
+		}
+	}
+
+	ds3231_epoch_to_time_and_calendar(epoch, &time_struct);
+
+	_ds3231_time_block_from_time_and_calendar(&time_struct, mock_registers);
+}
+
+/*The INT pin is low when INTCN is set and an alarm with its interrupt enabled has its flag set*/
+static int mock_interrupt_asserted(void)
+{
+	uint8_t control = mock_registers[DS3231_REGISTER_CONTROL];
+	uint8_t status = mock_registers[DS3231_REGISTER_CONTROL_STATUS];
+
+	return ((control & (1 << DS3231_BIT_INTCN)) != 0) &&
+		   ((((control & (1 << DS3231_BIT_A1IE)) != 0) && ((status & (1 << DS3231_BIT_A1F)) != 0)) ||
+			(((control & (1 << DS3231_BIT_A2IE)) != 0) && ((status & (1 << DS3231_BIT_A2F)) != 0)));
+}
+
+int ds3231_mock_interface_init(uint8_t deviceAddress)
+{
+	const char *ppm = getenv("DS3231_MOCK_PPM");
+	const char *offset_ms = getenv("DS3231_MOCK_OFFSET_MS");
+
+	memset(mock_registers, 0, sizeof(mock_registers));
+	mock_ppm = (ppm != NULL) ? atof(ppm) : 0.0;
+
+	mock_rebase(mock_clock_ns(CLOCK_REALTIME) + ((offset_ms != NULL) ? atoll(offset_ms) * 1000000LL : 0));
+	mock_alarm_checked = mock_now_epoch();
+	mock_bus_bytes = 0;
+
+	/*A 25 degrees reading*/
+	mock_registers[DS3231_REGISTER_TEMP_MSB] = 25;
+
+	return 0;
+}
+
+int ds3231_mock_interface_deinit(uint8_t deviceAddress)
+{
+	return 0;
+}
+
+int ds3231_mock_delay_function(uint32_t delayMS)
+{
+	if (usleep(1000 * delayMS) != 0)
+	{
+		return 1;
+	}
+
+	return 0;
+}
+
+int ds3231_mock_write_array(uint8_t deviceAddress, uint8_t startRegisterAddress, uint8_t *data, uint8_t dataLength)
+{
+	if ((startRegisterAddress + dataLength) > MOCK_NUMBER_OF_REGISTERS)
+	{
+		return 1;
+	}
+
+	/*The address and the register address, then the data*/
+	mock_bus_bytes += 2 + dataLength;
+
+	/*Keep the time running while the other registers are written*/
+	mock_time_to_registers();
+
+	/*Changing the aging offset changes the rate from now on only*/
+	int64_t now_ns = mock_now_ns();
+	int64_t fraction_ns = ((now_ns % 1000000000LL) + 1000000000LL) % 1000000000LL;
+
+	mock_rebase(now_ns);
+
+	for (uint8_t index = 0; index < dataLength; index++)
+	{
+		uint8_t register_address = (uint8_t)(startRegisterAddress + index);
+
+		if (register_address == DS3231_REGISTER_CONTROL_STATUS)
+		{
+			/*The flags can only be cleared, BSY is read only*/
+			uint8_t flags = (1 << DS3231_BIT_OSF) | (1 << DS3231_BIT_A2F) | (1 << DS3231_BIT_A1F);
+			uint8_t old_value = mock_registers[register_address];
+
+			mock_registers[register_address] = (uint8_t)((data[index] & ~flags & ~(1 << DS3231_BIT_BSY)) | (old_value & data[index] & flags));
+		}
+		else if (register_address == DS3231_REGISTER_CONTROL)
+		{
+			/*The temperature conversion is done instantly*/
+			mock_registers[register_address] = (uint8_t)(data[index] & ~(1 << DS3231_BIT_CONV));
+		}
+		else
+		{
+			mock_registers[register_address] = data[index];
+		}
+	}
+
+	/*Writing the seconds resets the countdown chain, the simulated time restarts at the written second*/
+	if (startRegisterAddress == DS3231_REGISTER_SECONDS)
+	{
+		mock_rebase(_ds3231_epoch_from_time_block(mock_registers) * 1000000000LL);
+		mock_alarm_checked = mock_now_epoch();
+	}
+	else if (startRegisterAddress <= DS3231_REGISTER_YEAR)
+	{
+		mock_rebase(_ds3231_epoch_from_time_block(mock_registers) * 1000000000LL + fraction_ns);
+		mock_alarm_checked = mock_now_epoch();
+	}
+
+	return 0;
+}
+
+int ds3231_mock_read_array(uint8_t deviceAddress, uint8_t startRegisterAddress, uint8_t *data, uint8_t dataLength)
+{
+	if ((startRegisterAddress + dataLength) > MOCK_NUMBER_OF_REGISTERS)
+	{
+		return 1;
+	}
+
+	/*The address and the register address, the address again, then the data*/
+	mock_bus_bytes += 3 + dataLength;
+
+	mock_time_to_registers();
+
+	memcpy(data, &mock_registers[startRegisterAddress], dataLength);
+
+	return 0;
+}
+
+int ds3231_mock_interface_ack_test(uint8_t deviceAddress)
+{
+	mock_bus_bytes += 1;
+
+	return 0;
+}
+
+int ds3231_mock_wait_for_interrupt(uint32_t timeout_s)
+{
+	for (uint32_t elapsed = 0;; elapsed++)
+	{
+		mock_time_to_registers();
+		if (mock_interrupt_asserted())
+		{
+			return 0;
+		}
+		if (elapsed >= timeout_s)
+		{
+			return 1;
+		}
+
+		/*Skip a second ahead instead of sleeping*/
+		mock_base_ns += 1000000000LL;
+	}
+}
+
+uint32_t ds3231_mock_bus_bytes(void)
+{
+	return mock_bus_bytes;
+}
@@ -0,0 +1,25 @@
+#ifndef __MOCK_INTERFACE_H__
+#define __MOCK_INTERFACE_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ds3231.h"
+
+/*A simulated DS3231 for trying the tool without hardware. It starts at the system time, optionally offset by DS3231_MOCK_OFFSET_MS milliseconds, and drifts by DS3231_MOCK_PPM parts per million*/
+int ds3231_mock_interface_init(uint8_t deviceAddress);
+int ds3231_mock_interface_deinit(uint8_t deviceAddress);
+int ds3231_mock_delay_function(uint32_t delayMS);
+int ds3231_mock_write_array(uint8_t deviceAddress, uint8_t startRegisterAddress, uint8_t *data, uint8_t dataLength);
+int ds3231_mock_read_array(uint8_t deviceAddress, uint8_t startRegisterAddress, uint8_t *data, uint8_t dataLength);
+int ds3231_mock_interface_ack_test(uint8_t deviceAddress);
+
+/*Advances the simulated time a second at a time, without sleeping, until the INT pin is asserted by an alarm. Returns 1 on timeout*/
+int ds3231_mock_wait_for_interrupt(uint32_t timeout_s);
+/*The I2C bytes transferred since the init, addresses included*/
+uint32_t ds3231_mock_bus_bytes(void);
+
+#endif
@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ds3231.h"
+#include "mock_interface.h"
+
+ds3231_handle_t handle;
+char *log_message;
+
+/*The simulation starts at 2025-01-01 00:00:00 UTC*/
+static const ds3231_epoch_t simulation_start = 1735689600LL;
+
+#define SECONDS_PER_DAY 86400
+
+#define PRINT_ERROR(str, error)                           \
+	do                                                    \
+	{                                                     \
+		ds3231_error_string(error, &log_message);         \
+		fprintf(stderr, "%s %s\n", str, log_message);     \
+	} while (0)
+
+typedef struct
+{
+	const char *name;
+	uint32_t period;
+	uint32_t tolerance;
+} simulation_task_t;
+
+/*A typical battery node: the deadlines are fixed, how early each task may run is its tolerance*/
+static const simulation_task_t tasks[] = {
+	{"sensor sample", 300, 60},
+	{"radio uplink", 900, 300},
+	{"log flush", 3600, 600},
+	{"battery check", 2220, 180},
+	{"time sync", 21600, 1800},
+};
+
+#define NUMBER_OF_TASKS (sizeof(tasks) / sizeof(tasks[0]))
+
+static void planner_setup(ds3231_wake_planner_t *planner, int heartbeat)
+{
+	ds3231_wake_planner_init(planner);
+
+	for (uint8_t index = 0; index < NUMBER_OF_TASKS; index++)
+	{
+		ds3231_wake_planner_add(planner, simulation_start + tasks[index].period, tasks[index].tolerance, tasks[index].period, NULL);
+	}
+
+	/*An hourly wake up the application has anyway, at minute 00*/
+	if (heartbeat)
+	{
+		planner->use_heartbeat = DS3231_TRUE;
+		planner->heartbeat.minute = 0;
+		planner->heartbeat.hour = 0;
+		planner->heartbeat.day_date.date = 1;
+		planner->heartbeat.day_date_type = DS3231_ALARM_DATE;
+		planner->heartbeat.alarm_rate = DS3231_ALARM2_MATCH_MINUTE;
+	}
+}
+
+static int simulate(int heartbeat, uint32_t days)
+{
+	ds3231_wake_planner_t planner;
+	ds3231_wake_estimate_t estimate;
+	uint32_t runs[NUMBER_OF_TASKS] = {0};
+	uint32_t wakes = 0;
+	uint32_t naive = 0;
+
+	planner_setup(&planner, heartbeat);
+
+	ds3231_error_code_t error = ds3231_wake_planner_estimate(&planner, simulation_start, days * SECONDS_PER_DAY, &estimate);
+	if (error != DS3231_ERROR_OK)
+	{
+		PRINT_ERROR("ESTIMATE ERR:", error);
+		return 1;
+	}
+
+	error = ds3231_set_all_time_and_calendar_from_epoch(&handle, simulation_start);
+	if (error == DS3231_ERROR_OK)
+	{
+		error = ds3231_wake_planner_start(&handle, &planner);
+	}
+	if (error != DS3231_ERROR_OK)
+	{
+		PRINT_ERROR("START ERR:", error);
+		return 1;
+	}
+
+	ds3231_epoch_t now = simulation_start;
+	ds3231_epoch_t end = simulation_start + (ds3231_epoch_t)days * SECONDS_PER_DAY;
+	uint32_t bus_bytes = 0;
+
+	/*Sleep until the alarm interrupt, then serve the due tasks, until the last day is over*/
+	while ((now < end) && (ds3231_mock_wait_for_interrupt((uint32_t)(end - now)) == 0))
+	{
+		ds3231_time_and_calendar_t time_struct;
+		uint32_t bus_bytes_before = ds3231_mock_bus_bytes();
+		uint32_t due;
+
+		error = ds3231_wake_planner_service(&handle, &planner, &due);
+		if (error != DS3231_ERROR_OK)
+		{
+			PRINT_ERROR("SERVICE ERR:", error);
+			return 1;
+		}
+
+		bus_bytes += ds3231_mock_bus_bytes() - bus_bytes_before;
+		wakes++;
+		for (uint8_t index = 0; index < NUMBER_OF_TASKS; index++)
+		{
+			runs[index] += (due >> index) & 1;
+		}
+
+		/*Only to know when to stop, not counted*/
+		ds3231_get_all_time_and_calendar(&handle, &time_struct);
+		ds3231_time_and_calendar_to_epoch(&time_struct, &now);
+	}
+
+	printf("%s\n", heartbeat ? "WITH AN HOURLY HEARTBEAT ON ALARM 2" : "ALARM 1 ONLY");
+	for (uint8_t index = 0; index < NUMBER_OF_TASKS; index++)
+	{
+		naive += SECONDS_PER_DAY / tasks[index].period;
+		printf("  %-14s every %5u s, up to %4u s early: %5.1f runs per day\n", tasks[index].name, tasks[index].period, tasks[index].tolerance, (double)runs[index] / days);
+	}
+	printf("  WAKE UPS PER DAY: %u one per task run, %.1f planned (%.1f alarm 1, %.1f alarm 2), %.1f simulated\n", naive, (double)estimate.wakes / days,
+		   (double)estimate.alarm_1_wakes / days, (double)estimate.alarm_2_wakes / days, (double)wakes / days);
+	printf("  BUS BYTES PER DAY: %.1f planned, %.1f simulated\n", (double)estimate.bus_bytes / days, (double)bus_bytes / days);
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t days = (argc > 1) ? (uint32_t)atoi(argv[1]) : 7;
+
+	if (days == 0)
+	{
+		fprintf(stderr, "usage: %s [DAYS]\n", argv[0]);
+		return 2;
+	}
+
+	memset(&handle, 0, sizeof(handle));
+	handle.interface.delay_function = ds3231_mock_delay_function;
+	handle.interface.interface_deinit = ds3231_mock_interface_deinit;
+	handle.interface.interface_init = ds3231_mock_interface_init;
+	handle.interface.read_array = ds3231_mock_read_array;
+	handle.interface.write_array = ds3231_mock_write_array;
+	handle.interface.interface_ack_test = ds3231_mock_interface_ack_test;
+
+	ds3231_error_code_t error = ds3231_init(&handle);
+	if (error != DS3231_ERROR_OK)
+	{
+		PRINT_ERROR("INIT ERR:", error);
+		return 1;
+	}
+
+	/*As on a node, the checks are done once by ds3231_init*/
+	handle.policy = DS3231_POLICY_LEAN;
+
+	error = ds3231_int_sqw_pin_select(&handle, DS3231_PIN_INTERRUPT);
+	if (error != DS3231_ERROR_OK)
+	{
+		PRINT_ERROR("PIN ERR:", error);
+		return 1;
+	}
+
+	printf("%u SIMULATED DAYS\n", days);
+
+	int result = simulate(0, days);
+	if (result == 0)
+	{
+		result = simulate(1, days);
+	}
+
+	ds3231_deinit(&handle);
+
+	return result;
+}